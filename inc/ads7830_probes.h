@@ -0,0 +1,83 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef ADS7830_PROBES_H
+#define ADS7830_PROBES_H
+
+/*============================================================================*/
+/*!
+@file ads7830_probes.h
+
+    ADS7830 Static Tracepoints
+
+    SystemTap compatible USDT probes for the ads7830 acquisition path.
+    When the build defines HAVE_SYS_SDT_H the probes are emitted as
+    NOP instructions with an ELF note describing their arguments, so
+    they can be attached with bpftrace or perf without rebuilding.
+    Otherwise the probes compile out completely.
+
+    Available probes (provider "ads7830"):
+
+        wait_wakeup( signum, id )
+        signal_dispatch( signum, id )
+        bus_start( channel, address )
+        bus_end( channel, address, value, result )
+        var_set_start( channel, hVar, value )
+        var_set_end( channel, hVar, value, result )
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#ifdef HAVE_SYS_SDT_H
+#include <sys/sdt.h>
+#endif
+
+/*==============================================================================
+        Public definitions
+==============================================================================*/
+
+#ifdef HAVE_SYS_SDT_H
+
+#define ADS7830_PROBE2( name, a1, a2 ) \
+    DTRACE_PROBE2( ads7830, name, a1, a2 )
+
+#define ADS7830_PROBE3( name, a1, a2, a3 ) \
+    DTRACE_PROBE3( ads7830, name, a1, a2, a3 )
+
+#define ADS7830_PROBE4( name, a1, a2, a3, a4 ) \
+    DTRACE_PROBE4( ads7830, name, a1, a2, a3, a4 )
+
+#else
+
+#define ADS7830_PROBE2( name, a1, a2 ) do { } while( 0 )
+#define ADS7830_PROBE3( name, a1, a2, a3 ) do { } while( 0 )
+#define ADS7830_PROBE4( name, a1, a2, a3, a4 ) do { } while( 0 )
+
+#endif
+
+#endif /* ADS7830_PROBES_H */
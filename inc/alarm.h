@@ -0,0 +1,91 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef ALARM_H
+#define ALARM_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! alarm states, as published to an alarm variable */
+typedef enum _alarm_state
+{
+    /*! the value is within its limits */
+    ALARM_NORMAL = 0,
+
+    /*! the value is below its low limit */
+    ALARM_LOW = 1,
+
+    /*! the value is above its high limit */
+    ALARM_HIGH = 2
+} AlarmState;
+
+/*! the _alarm structure holds a threshold alarm definition
+    and its current state */
+typedef struct _alarm
+{
+    /*! indicates if the high limit is checked */
+    bool hasHigh;
+
+    /*! indicates if the low limit is checked */
+    bool hasLow;
+
+    /*! high limit */
+    float high;
+
+    /*! low limit */
+    float low;
+
+    /*! distance the value must move back inside a limit to clear */
+    float hysteresis;
+
+    /*! time a transition must persist before it is reported,
+        in microseconds */
+    uint64_t duration;
+
+    /*! current (reported) alarm state */
+    AlarmState state;
+
+    /*! alarm state waiting for the minimum duration */
+    AlarmState pending;
+
+    /*! timestamp at which the pending state was first seen */
+    uint64_t since;
+} Alarm;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+bool ALARM_Evaluate( Alarm *pAlarm, float value, uint64_t now );
+
+#endif /* ALARM_H */
@@ -0,0 +1,63 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _arena structure manages a single fixed size block of memory
+    from which runtime state is carved at configuration time */
+typedef struct _arena
+{
+    /*! pointer to the start of the arena */
+    uint8_t *pBase;
+
+    /*! size of the arena in bytes */
+    size_t size;
+
+    /*! number of bytes allocated from the arena */
+    size_t used;
+} Arena;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+size_t ARENA_Reserve( size_t size, size_t align );
+int ARENA_Init( Arena *pArena, size_t size );
+void *ARENA_Alloc( Arena *pArena, size_t size, size_t align );
+char *ARENA_StrDup( Arena *pArena, const char *str );
+void ARENA_Release( Arena *pArena );
+
+#endif /* ARENA_H */
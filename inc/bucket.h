@@ -0,0 +1,73 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef BUCKET_H
+#define BUCKET_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _token_bucket structure tracks a transaction rate budget.
+    The level is held in millionths of a token so it can be refilled
+    with integer arithmetic from a microsecond timestamp. */
+typedef struct _token_bucket
+{
+    /*! refill rate in tokens per second (0 for unlimited) */
+    uint32_t rate;
+
+    /*! bucket capacity in millionths of a token */
+    int64_t capacity;
+
+    /*! current level in millionths of a token */
+    int64_t level;
+
+    /*! timestamp of the last refill in microseconds */
+    uint64_t last;
+} TokenBucket;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+void BUCKET_Init( TokenBucket *pBucket,
+                  uint32_t rate,
+                  uint32_t burst,
+                  uint64_t now );
+void BUCKET_Configure( TokenBucket *pBucket,
+                       uint32_t rate,
+                       uint32_t burst,
+                       uint64_t now );
+bool BUCKET_Take( TokenBucket *pBucket, uint32_t count, uint64_t now );
+void BUCKET_Charge( TokenBucket *pBucket, uint64_t now );
+uint64_t BUCKET_Delay( TokenBucket *pBucket, uint32_t count, uint64_t now );
+
+#endif /* BUCKET_H */
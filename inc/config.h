@@ -0,0 +1,329 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <tjson/json.h>
+
+/*==============================================================================
+        Public definitions
+==============================================================================*/
+
+/*! the number of channels on each ADS7830 chip */
+#define ADS7830_NUM_CHANNELS 8
+
+/*! compiled configuration magic number ("A7CF") */
+#define CONFIG_MAGIC 0x46433741
+
+/*! compiled configuration format version */
+#define CONFIG_VERSION 15
+
+/*! maximum number of decimal places for fixed-point publication */
+#define CONFIG_MAX_DECIMALS 9
+
+/*! default ADC reference voltage */
+#define CONFIG_DEFAULT_VREF 3.3f
+
+/*! ADS7830 internal reference voltage */
+#define CONFIG_INTERNAL_VREF 2.5f
+
+/*! alarm limit flag indicating the high limit is checked */
+#define CONFIG_ALARM_HIGH 0x01
+
+/*! alarm limit flag indicating the low limit is checked */
+#define CONFIG_ALARM_LOW 0x02
+
+/*! default consecutive failures which open the circuit breaker */
+#define CONFIG_HEALTH_THRESHOLD 3
+
+/*! default initial failure backoff in milliseconds */
+#define CONFIG_HEALTH_BACKOFF 10
+
+/*! default maximum failure backoff in milliseconds */
+#define CONFIG_HEALTH_BACKOFF_MAX 1000
+
+/*! default probe interval while the circuit breaker is open,
+    in milliseconds */
+#define CONFIG_HEALTH_PROBE 5000
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! channel input modes */
+typedef enum _config_input
+{
+    /*! the channel input is measured against COM */
+    CONFIG_INPUT_SINGLE_ENDED = 0,
+
+    /*! the channel input is measured against its pair channel input
+        (CH0/CH1, CH2/CH3, CH4/CH5, CH6/CH7) */
+    CONFIG_INPUT_DIFFERENTIAL = 1
+} ConfigInput;
+
+/*! power-down modes between conversions.  The values are the
+    PD1 PD0 bits of the ADS7830 command byte. */
+typedef enum _config_power
+{
+    /*! power down the reference and A/D converter */
+    CONFIG_POWER_DOWN = 0,
+
+    /*! internal reference off, A/D converter on */
+    CONFIG_POWER_ADC = 1,
+
+    /*! internal reference on, A/D converter off */
+    CONFIG_POWER_REF = 2,
+
+    /*! internal reference on, A/D converter on */
+    CONFIG_POWER_ON = 3
+} ConfigPower;
+
+/*! bus budget policies, selecting how periodic sampling is degraded
+    when the bus transaction budget is exhausted */
+typedef enum _config_budget_policy
+{
+    /*! skip periodic samples */
+    CONFIG_BUDGET_DROP = 0,
+
+    /*! delay periodic samples until the budget allows them */
+    CONFIG_BUDGET_STRETCH = 1
+} ConfigBudgetPolicy;
+
+/*! data source backends, selecting how channels are read */
+typedef enum _config_backend
+{
+    /*! i2c-dev write and read system calls per conversion */
+    CONFIG_BACKEND_I2C = 0,
+
+    /*! i2c-dev transfers batched through io_uring */
+    CONFIG_BACKEND_URING = 1,
+
+    /*! kernel hwmon driver inputs in millivolts */
+    CONFIG_BACKEND_HWMON = 2,
+
+    /*! kernel IIO driver raw inputs in counts */
+    CONFIG_BACKEND_IIO = 3,
+
+    /*! recorded samples played back from a file */
+    CONFIG_BACKEND_REPLAY = 4
+} ConfigBackend;
+
+/*! the _config_channel structure is the compiled definition of
+    a single ADS7830 channel */
+typedef struct _config_channel
+{
+    /*! string table offset of the channel variable name (0 if none) */
+    uint32_t var;
+
+    /*! sample interval in milliseconds (0 for on-demand) */
+    int32_t interval;
+
+    /*! minimum adaptive sample interval in milliseconds */
+    int32_t adaptMin;
+
+    /*! maximum adaptive sample interval in milliseconds (0 if fixed) */
+    int32_t adaptMax;
+
+    /*! sample-to-sample change in counts which shortens the interval */
+    int32_t adaptThreshold;
+
+    /*! input mode (see ConfigInput) */
+    int32_t input;
+
+    /*! power-down mode after each conversion (see ConfigPower) */
+    int32_t power;
+
+    /*! reference voltage */
+    float vref;
+
+    /*! engineering unit scale factor */
+    float scale;
+
+    /*! engineering unit offset */
+    float offset;
+
+    /*! string table offset of the engineering units (0 if none) */
+    uint32_t units;
+
+    /*! decimal places for fixed-point integer publication (0 for counts) */
+    int32_t decimals;
+
+    /*! string table offset of the LUT_SIZE entry conversion table
+        (0 for the linear conversion) */
+    uint32_t table;
+
+    /*! alarm limits checked (CONFIG_ALARM_xxx flags, 0 for no alarm) */
+    uint32_t alarmLimits;
+
+    /*! string table offset of the alarm variable name
+        (0 for the default name) */
+    uint32_t alarmVar;
+
+    /*! alarm high limit in engineering units */
+    float alarmHigh;
+
+    /*! alarm low limit in engineering units */
+    float alarmLow;
+
+    /*! alarm hysteresis in engineering units */
+    float alarmHysteresis;
+
+    /*! minimum alarm transition duration in milliseconds */
+    int32_t alarmDuration;
+
+    /*! statistics window length in milliseconds (0 for no statistics) */
+    int32_t statsWindow;
+
+    /*! statistics publication interval in milliseconds */
+    int32_t statsInterval;
+
+    /*! maximum number of samples in the statistics window */
+    uint32_t statsSamples;
+} ConfigChannel;
+
+/*! the _config structure is the compiled ADS7830 configuration.
+    It is position independent (all strings and conversion tables are
+    stored as offsets into the trailing string table) so it can be
+    written to disk and mapped back in directly. */
+typedef struct _config
+{
+    /*! magic number */
+    uint32_t magic;
+
+    /*! format version */
+    uint32_t version;
+
+    /*! total size of the compiled configuration in bytes */
+    uint32_t size;
+
+    /*! checksum of everything following the header */
+    uint32_t checksum;
+
+    /*! modification time of the source file in nanoseconds */
+    int64_t srcMtime;
+
+    /*! size of the source file in bytes */
+    int64_t srcSize;
+
+    /*! string table offset of the I2C device name */
+    uint32_t device;
+
+    /*! device address on the I2C bus */
+    int32_t address;
+
+    /*! I2C adapter timeout in milliseconds (0 for the adapter default) */
+    int32_t timeout;
+
+    /*! I2C adapter retry count (-1 for the adapter default) */
+    int32_t retries;
+
+    /*! data source backend (see ConfigBackend) */
+    int32_t backend;
+
+    /*! string table offset of the sysfs device directory (0 if none) */
+    uint32_t sysfs;
+
+    /*! string table offset of the replay recording file (0 if none) */
+    uint32_t replayFile;
+
+    /*! replay speed relative to the recording (0 for unpaced) */
+    float replaySpeed;
+
+    /*! default power-down mode (see ConfigPower) */
+    int32_t power;
+
+    /*! bus transaction budget in transactions per second (0 for none) */
+    uint32_t budgetRate;
+
+    /*! bus transaction budget burst size in transactions */
+    uint32_t budgetBurst;
+
+    /*! bus budget policy (see ConfigBudgetPolicy) */
+    int32_t budgetPolicy;
+
+    /*! string table offset of the packed scan variable name (0 if none) */
+    uint32_t scanVar;
+
+    /*! packed scan interval in milliseconds */
+    int32_t scanInterval;
+
+    /*! string table offset of the health variable name (0 if none) */
+    uint32_t healthVar;
+
+    /*! consecutive failures which open the circuit breaker */
+    uint32_t healthThreshold;
+
+    /*! initial failure backoff in milliseconds */
+    uint32_t healthBackoff;
+
+    /*! maximum failure backoff in milliseconds */
+    uint32_t healthBackoffMax;
+
+    /*! probe interval while the circuit breaker is open in milliseconds */
+    uint32_t healthProbe;
+
+    /*! channel definitions indexed by channel number */
+    ConfigChannel channels[ADS7830_NUM_CHANNELS];
+
+    /*! size of the string table in bytes */
+    uint32_t strtabSize;
+
+    /*! string table */
+    char strtab[];
+} Config;
+
+/*! the _config_image structure manages the storage of
+    a compiled configuration */
+typedef struct _config_image
+{
+    /*! pointer to the compiled configuration */
+    Config *pConfig;
+
+    /*! size of the configuration storage */
+    size_t size;
+
+    /*! indicates if the configuration is mapped from a cache file */
+    bool mapped;
+} ConfigImage;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+int CONFIG_Compile( JNode *pNode, char *pFileName, ConfigImage *pImage );
+int CONFIG_Load( char *pCacheFile, char *pFileName, ConfigImage *pImage );
+int CONFIG_Save( ConfigImage *pImage, char *pCacheFile );
+void CONFIG_Release( ConfigImage *pImage );
+char *CONFIG_GetStr( Config *pConfig, uint32_t offset );
+const float *CONFIG_GetTable( Config *pConfig, uint32_t offset );
+
+#endif /* CONFIG_H */
@@ -0,0 +1,106 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef HEALTH_H
+#define HEALTH_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! device health states, as published to a health variable */
+typedef enum _health_state
+{
+    /*! the device is responding */
+    HEALTH_OK = 0,
+
+    /*! recent transactions failed and the device is being backed off */
+    HEALTH_DEGRADED = 1,
+
+    /*! the circuit breaker is open and the device is only probed */
+    HEALTH_FAILED = 2
+} HealthState;
+
+/*! the _health structure tracks the health of a bus device, and
+    decides when a transaction may be attempted */
+typedef struct _health
+{
+    /*! consecutive failures which open the circuit breaker */
+    uint32_t threshold;
+
+    /*! initial backoff after a failure in microseconds */
+    uint64_t backoffMin;
+
+    /*! maximum backoff in microseconds */
+    uint64_t backoffMax;
+
+    /*! interval between probes while the breaker is open,
+        in microseconds */
+    uint64_t probeInterval;
+
+    /*! current health state */
+    HealthState state;
+
+    /*! number of consecutive failures */
+    uint32_t failures;
+
+    /*! backoff to apply after the next failure in microseconds */
+    uint64_t backoff;
+
+    /*! timestamp before which no transaction is attempted */
+    uint64_t retryAt;
+
+    /*! total number of failed transactions */
+    uint64_t errors;
+
+    /*! number of times the circuit breaker opened */
+    uint64_t trips;
+
+    /*! number of probe transactions while the breaker was open */
+    uint64_t probes;
+
+    /*! number of recoveries from the failed state */
+    uint64_t recoveries;
+} Health;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+void HEALTH_Init( Health *pHealth,
+                  uint32_t threshold,
+                  uint64_t backoffMin,
+                  uint64_t backoffMax,
+                  uint64_t probeInterval );
+bool HEALTH_Allow( Health *pHealth, uint64_t now );
+bool HEALTH_Report( Health *pHealth, bool success, uint64_t now );
+
+#endif /* HEALTH_H */
@@ -0,0 +1,90 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef LUT_H
+#define LUT_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*==============================================================================
+        Public definitions
+==============================================================================*/
+
+/*! number of entries in a conversion table (one per 8-bit ADC count) */
+#define LUT_SIZE 256
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _lut_point structure defines a conversion table breakpoint */
+typedef struct _lut_point
+{
+    /*! ADC counts */
+    float counts;
+
+    /*! engineering value at the specified counts */
+    float value;
+} LUTPoint;
+
+/*! the _lut_thermistor structure defines an NTC thermistor connected
+    between the ADC input and ground, with a series resistor between
+    the ADC input and the reference voltage */
+typedef struct _lut_thermistor
+{
+    /*! series resistance in ohms */
+    double rseries;
+
+    /*! Steinhart-Hart A coefficient */
+    double a;
+
+    /*! Steinhart-Hart B coefficient */
+    double b;
+
+    /*! Steinhart-Hart C coefficient */
+    double c;
+
+    /*! beta coefficient (used instead of A, B, C if non-zero) */
+    double beta;
+
+    /*! nominal resistance at the nominal temperature (beta model) */
+    double r0;
+
+    /*! nominal temperature in degrees Celsius (beta model) */
+    double t0;
+} LUTThermistor;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+int LUT_Breakpoints( LUTPoint *pPoints, size_t n, float *pTable );
+int LUT_Thermistor( LUTThermistor *pThermistor, float *pTable );
+
+#endif /* LUT_H */
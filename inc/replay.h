@@ -0,0 +1,100 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*==============================================================================
+        Public definitions
+==============================================================================*/
+
+/*! number of channels which can be replayed */
+#define REPLAY_MAX_CHANNELS 8
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _replay_sample structure holds one recorded sample */
+typedef struct _replay_sample
+{
+    /*! timestamp of the sample in microseconds */
+    uint64_t time;
+
+    /*! channel the sample was taken from */
+    uint8_t channel;
+
+    /*! sampled value in counts */
+    uint8_t value;
+} ReplaySample;
+
+/*! the _replay structure holds a recorded sample stream and the
+    position of its playback */
+typedef struct _replay
+{
+    /*! recorded samples in time order */
+    ReplaySample *pSamples;
+
+    /*! number of recorded samples */
+    size_t count;
+
+    /*! index of the next sample to play */
+    size_t next;
+
+    /*! timestamp of the first recorded sample in microseconds */
+    uint64_t origin;
+
+    /*! timestamp at which playback started in microseconds */
+    uint64_t start;
+
+    /*! playback speed relative to the recording (0 for unpaced) */
+    float speed;
+
+    /*! most recently played value of each channel */
+    uint8_t value[REPLAY_MAX_CHANNELS];
+
+    /*! indicates if a value has been played for each channel */
+    bool valid[REPLAY_MAX_CHANNELS];
+} Replay;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+int REPLAY_Load( Replay *pReplay, const char *pFileName );
+void REPLAY_Release( Replay *pReplay );
+void REPLAY_Start( Replay *pReplay, float speed, uint64_t now );
+int REPLAY_Next( Replay *pReplay, int *pChannel );
+uint64_t REPLAY_Due( Replay *pReplay );
+int REPLAY_Read( Replay *pReplay, int channel, uint8_t *data );
+
+#endif /* REPLAY_H */
@@ -0,0 +1,79 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef RT_H
+#define RT_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*==============================================================================
+        Definitions
+==============================================================================*/
+
+/*! number of stack bytes to prefault when memory is locked */
+#define RT_PREFAULT_STACK ( 64 * 1024 )
+
+/*! result of a real-time setting which was not requested */
+#define RT_NOT_REQUESTED ( -1 )
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _rt_profile structure describes the real-time execution profile
+    of a thread, and records whether each setting could be applied */
+typedef struct _rt_profile
+{
+    /*! SCHED_FIFO priority (0 to keep the default scheduling policy) */
+    int priority;
+
+    /*! lock all current and future pages into memory */
+    bool lock;
+
+    /*! CPU affinity mask (0 to run on any CPU) */
+    uint64_t affinity;
+
+    /*! result of setting the scheduling policy */
+    int schedResult;
+
+    /*! result of locking memory */
+    int lockResult;
+
+    /*! result of setting the CPU affinity */
+    int affinityResult;
+} RTProfile;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+int RT_Apply( RTProfile *pProfile );
+const char *RT_Result( int result );
+
+#endif /* RT_H */
@@ -0,0 +1,125 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef STATS_H
+#define STATS_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "arena.h"
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _window_stats structure maintains the statistics of the samples
+    within a sliding time window.  Samples are held in a ring buffer, and
+    the minimum and maximum are tracked with monotonic deques of sample
+    sequence numbers, so adding a sample is O(1) amortized. */
+typedef struct _window_stats
+{
+    /*! ring buffer capacity in samples (a power of 2, 0 if unused) */
+    uint32_t capacity;
+
+    /*! window length in microseconds */
+    uint64_t window;
+
+    /*! sample values */
+    float *pValue;
+
+    /*! sample timestamps in microseconds */
+    uint64_t *pTime;
+
+    /*! sequence number of the next sample */
+    uint32_t seq;
+
+    /*! number of samples in the window */
+    uint32_t count;
+
+    /*! minimum deque of sequence numbers (increasing values) */
+    uint32_t *pMinQ;
+
+    /*! index of the first minimum deque entry */
+    uint32_t minHead;
+
+    /*! number of minimum deque entries */
+    uint32_t minCount;
+
+    /*! maximum deque of sequence numbers (decreasing values) */
+    uint32_t *pMaxQ;
+
+    /*! index of the first maximum deque entry */
+    uint32_t maxHead;
+
+    /*! number of maximum deque entries */
+    uint32_t maxCount;
+
+    /*! sum of the sample values in the window */
+    double sum;
+
+    /*! sum of the squared sample values in the window */
+    double sumSq;
+
+    /*! samples added since the sums were last recalculated */
+    uint32_t sinceRecalc;
+} WindowStats;
+
+/*! the _stats_result structure holds a snapshot of window statistics */
+typedef struct _stats_result
+{
+    /*! number of samples in the window */
+    uint32_t count;
+
+    /*! minimum sample value */
+    float min;
+
+    /*! maximum sample value */
+    float max;
+
+    /*! mean sample value */
+    float mean;
+
+    /*! standard deviation of the sample values */
+    float stddev;
+} StatsResult;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+uint32_t STATS_Capacity( uint32_t samples );
+size_t STATS_ArenaSize( uint32_t samples );
+int STATS_Init( WindowStats *pStats,
+                Arena *pArena,
+                uint32_t samples,
+                uint64_t window );
+int STATS_Copy( WindowStats *pDst, const WindowStats *pSrc );
+void STATS_Add( WindowStats *pStats, float value, uint64_t now );
+int STATS_Get( WindowStats *pStats, uint64_t now, StatsResult *pResult );
+
+#endif /* STATS_H */
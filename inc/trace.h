@@ -0,0 +1,74 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*==============================================================================
+        Public definitions
+==============================================================================*/
+
+/*! trace event identifiers */
+typedef enum _trace_event_id
+{
+    /*! periodic timer expiry handled by the event loop */
+    TRACE_EVENT_TIMER = 0,
+
+    /*! on-demand CALC request handled by the event loop */
+    TRACE_EVENT_CALC,
+
+    /*! PRINT request handled by the event loop */
+    TRACE_EVENT_PRINT,
+
+    /*! I2C bus transaction */
+    TRACE_EVENT_I2C,
+
+    /*! variable server update */
+    TRACE_EVENT_VARSET,
+
+    /*! packed scan of all channels handled by the event loop */
+    TRACE_EVENT_SCAN,
+
+    /*! number of trace event identifiers */
+    TRACE_EVENT_MAX
+
+} TraceEventID;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+int TRACE_Init( size_t size );
+uint64_t TRACE_Begin( void );
+void TRACE_End( TraceEventID id, int arg, uint64_t start );
+int TRACE_Dump( int fd );
+
+#endif /* TRACE_H */
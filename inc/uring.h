@@ -0,0 +1,102 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+#ifndef URING_H
+#define URING_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _uring structure holds an io_uring submission and completion
+    queue pair mapped from the kernel */
+typedef struct _uring
+{
+    /*! io_uring file descriptor */
+    int fd;
+
+    /*! number of submission queue entries (0 if not set up) */
+    unsigned entries;
+
+    /*! mapped submission queue ring */
+    void *pSQ;
+
+    /*! size of the mapped submission queue ring */
+    size_t sqSize;
+
+    /*! mapped completion queue ring (may be the submission queue ring) */
+    void *pCQ;
+
+    /*! size of the mapped completion queue ring */
+    size_t cqSize;
+
+    /*! mapped submission queue entries */
+    void *pSQEs;
+
+    /*! size of the mapped submission queue entries */
+    size_t sqesSize;
+
+    /*! submission queue tail */
+    unsigned *sqTail;
+
+    /*! submission queue index mask */
+    unsigned *sqMask;
+
+    /*! submission queue index array */
+    unsigned *sqArray;
+
+    /*! completion queue head */
+    unsigned *cqHead;
+
+    /*! completion queue tail */
+    unsigned *cqTail;
+
+    /*! completion queue index mask */
+    unsigned *cqMask;
+
+    /*! completion queue entries */
+    void *pCQEs;
+} URing;
+
+/*==============================================================================
+        Public function declarations
+==============================================================================*/
+
+int URING_Init( URing *pRing, unsigned entries );
+void URING_Release( URing *pRing );
+int URING_Transfer( URing *pRing,
+                    int fd,
+                    const uint8_t *cmd,
+                    uint8_t *data,
+                    int *results,
+                    int count );
+
+#endif /* URING_H */
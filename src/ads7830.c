@@ -90,8 +90,8 @@ SOFTWARE.
         ]
     }
 
-    Channels can either be sampled on a periodic basis using a timer
-    for each channel, or can be sampled on demand using a system
+    Channels can either be sampled on a periodic basis using a sample
+    deadline for each channel, or can be sampled on demand using a system
     variable CALC notification.
 
     The ads7830 application can either be given exclusive access
@@ -114,29 +114,83 @@ SOFTWARE.
 #include <fcntl.h>
 #include <signal.h>
 #include <time.h>
+#include <math.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <varserver/varserver.h>
 #include <tjson/json.h>
 #include <linux/i2c.h>
 #include <linux/i2c-dev.h>
+#include "ads7830_probes.h"
+#include "config.h"
+#include "arena.h"
+#include "lut.h"
+#include "bucket.h"
+#include "alarm.h"
+#include "stats.h"
+#include "health.h"
+#include "uring.h"
+#include "sysfs.h"
+#include "replay.h"
+#include "rt.h"
+#include "trace.h"
+#include "flight.h"
+#include "timestamp.h"
+#include "clock.h"
 
 /*==============================================================================
         Private definitions
 ==============================================================================*/
 
-/*! the number of channels on each ADS7830 chip */
-#define ADS7830_NUM_CHANNELS 8
-
-/*! timer notification */
+/*! sample deadline notification (reported when a wait times out) */
 #define TIMER_NOTIFICATION SIGRTMIN+5
 
+/*! cache line size used to align the hot channel state */
+#define ADS7830_CACHE_LINE 64
+
+/*! flight recorder dump notification */
+#define FLIGHT_NOTIFICATION SIGUSR1
+
+/*! configuration reload notification */
+#define RELOAD_NOTIFICATION SIGHUP
+
+/*! default flight recorder dump file */
+#define FLIGHT_DUMP_FILE "/tmp/ads7830.flight"
+
+/*! maximum number of on-demand samples taken ahead of a due periodic
+    sample before the periodic sample is forced */
+#define ADS7830_INTERACTIVE_BURST 4
+
+/*! shortest sampling interval accepted from an INTERVAL control
+    variable in milliseconds */
+#define ADS7830_MIN_CONTROL_INTERVAL 10
+
+/*! maximum length of the packed scan variable value */
+#define ADS7830_SCAN_LEN 64
+
+/*! number of rolling window statistics companion variables */
+#define ADS7830_NUM_STATS 4
+
+/*! simulated duration of a conversion in microseconds (a command
+    write and a data read at 100 kHz) */
+#define ADS7830_SIM_CONVERSION 400
+
+/*! command byte single-ended input select bit */
+#define ADS7830_CMD_SINGLE_ENDED 0x80
+
+/*! command byte power-down select shift */
+#define ADS7830_CMD_PD_SHIFT 2
+
+/*! command byte channel select shift */
+#define ADS7830_CMD_CHANNEL_SHIFT 4
+
 /*==============================================================================
         Type definitions
 ==============================================================================*/
 
 /*! the _ain structure maintains a link between each analog input
-    and its associated system variable. */
+    and its associated system variable.  It holds the cold channel
+    state which is only touched on configuration or control changes. */
 typedef struct _ain
 {
     /*! channel number */
@@ -151,10 +205,129 @@ typedef struct _ain
     /*! sample timer in milliseconds */
     int interval;
 
-    /*! sample timer */
-    timer_t timer;
+    /*! configured sample timer in milliseconds */
+    int cfgInterval;
+
+    /*! minimum adaptive sample interval in milliseconds */
+    int adaptMin;
+
+    /*! maximum adaptive sample interval in milliseconds (0 if fixed) */
+    int adaptMax;
+
+    /*! sample-to-sample change in counts which shortens the interval */
+    int adaptThreshold;
+
+    /*! input mode (see ConfigInput) */
+    int input;
+
+    /*! power-down mode after each conversion (see ConfigPower) */
+    int power;
+
+    /*! indicates if a CALC notification has been requested */
+    bool calcNotify;
+
+    /*! indicates if sampling has been disabled at runtime */
+    bool disabled;
+
+    /*! handle to the optional sample interval control variable */
+    VAR_HANDLE hInterval;
+
+    /*! handle to the optional channel enable control variable */
+    VAR_HANDLE hEnable;
+
+    /*! reference voltage */
+    float vref;
+
+    /*! engineering unit scale factor */
+    float scale;
+
+    /*! engineering unit offset */
+    float offset;
+
+    /*! engineering units */
+    char *units;
+
+    /*! decimal places for fixed-point publication (0 for counts) */
+    int decimals;
+
+    /*! conversion table (NULL for the linear conversion) */
+    const float *lut;
+
+    /*! name of the alarm variable (NULL if the channel has no alarm) */
+    char *alarmName;
+
+    /*! handle to the alarm variable */
+    VAR_HANDLE hAlarm;
+
+    /*! threshold alarm definition and state */
+    Alarm alarm;
+
+    /*! rolling window statistics (capacity 0 if not enabled) */
+    WindowStats stats;
+
+    /*! statistics publication interval in microseconds */
+    uint64_t statsInterval;
+
+    /*! next statistics publication time in microseconds */
+    uint64_t statsNext;
+
+    /*! handles to the MIN, MAX, MEAN and STDDEV companion variables */
+    VAR_HANDLE hStats[ADS7830_NUM_STATS];
 } AIN;
 
+/*! the _ain_hot structure holds the channel state which is touched on
+    every scheduler tick or sample.  Each field is an array indexed by
+    channel so a scan over the channels touches the minimum number of
+    cache lines, and the block is cache line aligned so the hot state
+    of one device never shares a cache line with another. */
+typedef struct _ain_hot
+{
+    /*! next sample deadline in microseconds (0 if not scheduled) */
+    uint64_t deadline[ADS7830_NUM_CHANNELS];
+
+    /*! sample period in microseconds */
+    uint64_t period[ADS7830_NUM_CHANNELS];
+
+    /*! timestamp of the last sample in microseconds */
+    uint64_t timestamp[ADS7830_NUM_CHANNELS];
+
+    /*! minimum adaptive sample period in microseconds */
+    uint64_t minPeriod[ADS7830_NUM_CHANNELS];
+
+    /*! maximum adaptive sample period in microseconds (0 if fixed) */
+    uint64_t maxPeriod[ADS7830_NUM_CHANNELS];
+
+    /*! engineering units per count */
+    float gain[ADS7830_NUM_CHANNELS];
+
+    /*! engineering unit offset */
+    float offset[ADS7830_NUM_CHANNELS];
+
+    /*! fixed-point multiplier (0 to publish raw counts) */
+    float fixed[ADS7830_NUM_CHANNELS];
+
+    /*! conversion table (NULL for the linear conversion) */
+    const float *lut[ADS7830_NUM_CHANNELS];
+
+    /*! type of the channel variable */
+    VarType type[ADS7830_NUM_CHANNELS];
+
+    /*! ADS7830 command byte used to sample the channel */
+    uint8_t command[ADS7830_NUM_CHANNELS];
+
+    /*! sample-to-sample change in counts which shortens the period */
+    uint8_t threshold[ADS7830_NUM_CHANNELS];
+
+    /*! last sampled value */
+    uint16_t value[ADS7830_NUM_CHANNELS];
+
+    /*! next packed scan deadline in microseconds (0 if not scheduled) */
+    uint64_t scanDeadline;
+
+    /*! packed scan period in microseconds */
+    uint64_t scanPeriod;
+} __attribute__(( aligned( ADS7830_CACHE_LINE ) )) AINHot;
+
 /*! the _ads7830 structure manages the ADS7830 data acquisition context */
 typedef struct _ads7830
 {
@@ -176,17 +349,134 @@ typedef struct _ads7830
     /*! output config */
     bool output;
 
+    /*! number of events held in the timeline trace buffer */
+    size_t traceSize;
+
+    /*! name of the file to dump the flight recorder to on SIGUSR1 */
+    char *pFlightFile;
+
     /*! handle to the I2C device */
     int fd;
 
     /*! handle to the variable server */
     VARSERVER_HANDLE hVarServer;
 
+    /*! name of the compiled configuration cache file */
+    char *pCacheFile;
+
+    /*! compile the configuration cache and exit */
+    bool compileOnly;
+
+    /*! runtime state arena for the active configuration */
+    Arena arena;
+
+    /*! handle to the ADS7830 status variable */
+    VAR_HANDLE hInfo;
+
+    /*! handle to the ADS7830 timeline trace variable */
+    VAR_HANDLE hTrace;
+
+    /*! handle to the ADS7830 flight recorder variable */
+    VAR_HANDLE hFlight;
+
     /*! device address on the I2C bus */
     int address;
 
+    /*! I2C adapter timeout in milliseconds (0 for the adapter default) */
+    int busTimeout;
+
+    /*! I2C adapter retry count (-1 for the adapter default) */
+    int busRetries;
+
+    /*! result of applying the adapter timeout and retry count */
+    int busResult;
+
+    /*! data source backend (see ConfigBackend) */
+    int backend;
+
+    /*! io_uring for the io_uring backend */
+    URing ring;
+
+    /*! channel input attributes of the kernel driver backends */
+    int sysfsFd[ADS7830_NUM_CHANNELS];
+
+    /*! recording played by the replay backend */
+    Replay replay;
+
+    /*! name of the recording played by the replay backend */
+    char *replayFile;
+
+    /*! sysfs device directory of the kernel driver backends */
+    char *sysfsDir;
+
+    /*! duration of the last unpaced replay in microseconds */
+    uint64_t replayElapsed;
+
+    /*! on-demand samples taken since the last periodic sample */
+    int interactiveRun;
+
+    /*! number of on-demand samples taken ahead of due periodic samples */
+    uint64_t preemptions;
+
+    /*! number of periodic samples forced ahead of on-demand samples */
+    uint64_t starvationGuards;
+
+    /*! bus transaction budget */
+    TokenBucket budget;
+
+    /*! bus budget policy (see ConfigBudgetPolicy) */
+    int budgetPolicy;
+
+    /*! number of periodic samples dropped by the bus budget */
+    uint64_t budgetDropped;
+
+    /*! number of periodic samples delayed by the bus budget */
+    uint64_t budgetStretched;
+
+    /*! number of periodic samples taken */
+    uint64_t scheduled;
+
+    /*! total lateness of the periodic samples in microseconds */
+    uint64_t lateTotal;
+
+    /*! maximum lateness of a periodic sample in microseconds */
+    uint64_t lateMax;
+
+    /*! number of times a channel fell a full period behind its deadline */
+    uint64_t overruns;
+
+    /*! simulated run time in seconds (0 to run against the real clock) */
+    uint64_t simulate;
+
+    /*! real time taken by the simulated run in microseconds */
+    uint64_t simElapsed;
+
+    /*! suppresses all variable updates during a simulated run */
+    bool dryRun;
+
+    /*! real-time execution profile of the acquisition thread */
+    RTProfile rt;
+
+    /*! name of the packed scan variable (NULL if none) */
+    char *scanName;
+
+    /*! handle to the packed scan variable */
+    VAR_HANDLE hScan;
+
+    /*! device health tracker */
+    Health health;
+
+    /*! name of the device health variable (NULL if none) */
+    char *healthName;
+
+    /*! handle to the device health variable */
+    VAR_HANDLE hHealth;
+
     /*! Analog input channels */
     AIN channels[ADS7830_NUM_CHANNELS];
+
+    /*! hot Analog input channel state */
+    AINHot hot;
 } ADS7830;
 
 /*==============================================================================
@@ -203,18 +493,80 @@ ADS7830 *pADS7830State;
 void main(int argc, char **argv);
 static int ProcessOptions( int argC, char *argV[], ADS7830 *pADS7830 );
 static void usage( char *cmdname );
+static void InitState( ADS7830 *pADS7830 );
 static void SetupTerminationHandler( void );
 static void TerminationHandler( int signum, siginfo_t *info, void *ptr );
 static int run( ADS7830 *pADS7830 );
-static int WaitSignal( int *signum, int *id );
+static int Simulate( ADS7830 *pADS7830 );
+static void RunSchedule( ADS7830 *pADS7830, uint64_t duration );
+static int WaitSignal( int *signum, int *id, int64_t timeout );
+static int64_t GetTimeout( ADS7830 *pADS7830 );
+static int ServiceDeadlines( ADS7830 *pADS7830 );
+static int ServiceInteractive( ADS7830 *pADS7830 );
+static int ServiceScan( ADS7830 *pADS7830, uint64_t now );
+static void SetScan( ADS7830 *pADS7830, Config *pConfig, Arena *pArena );
 static int HandleSignal( ADS7830 *pADS7830, int signum, int id );
 static int FindChannel( ADS7830 *pADS7830, VAR_HANDLE hVar );
 static int ReadChannel( ADS7830 *pADS7830, int channel, uint8_t *data );
+static void ReadChannels( ADS7830 *pADS7830,
+                          const int *channels,
+                          int count,
+                          uint8_t *data,
+                          int *results );
+static int ReadRing( ADS7830 *pADS7830,
+                     const int *channels,
+                     uint8_t *data,
+                     int *results,
+                     int count );
+static void SetBackend( ADS7830 *pADS7830, Config *pConfig, Arena *pArena );
+static bool SameString( const char *s1, const char *s2 );
+static void OpenSysfs( ADS7830 *pADS7830,
+                       Config *pConfig,
+                       const char *format );
+static void CloseSysfs( ADS7830 *pADS7830 );
+static void StartReplay( ADS7830 *pADS7830, Config *pConfig );
+static void RunReplay( ADS7830 *pADS7830 );
+static int ServiceReplay( ADS7830 *pADS7830, uint64_t now );
+static int ReadSysfs( ADS7830 *pADS7830, int channel, uint8_t *data );
+static int ReadDevice( ADS7830 *pADS7830, int channel, uint8_t *data );
+static int OpenSession( ADS7830 *pADS7830, int *pfd );
+static void SetBusTiming( ADS7830 *pADS7830, int fd );
+static void UpdateHealth( ADS7830 *pADS7830, int result );
+static int PublishHealth( ADS7830 *pADS7830 );
+static int SetVar( ADS7830 *pADS7830, VAR_HANDLE hVar, VarObject *pVar );
+static void SetHealth( ADS7830 *pADS7830, Config *pConfig, Arena *pArena );
 static int SampleChannel( ADS7830 *pADS7830, int channel );
-static int CreateTimer( ADS7830 *pADS7830, int channel, int timeoutms );
-static int ParseChannel( JNode *pNode, void *arg );
+static void ConvertSample( ADS7830 *pADS7830,
+                           int channel,
+                           uint8_t data,
+                           VarObject *pVar );
+static float ToEngineering( AINHot *pHot, int channel, uint8_t data );
+static long long ToFixed( double value, double min, double max );
+static int LoadConfig( ADS7830 *pADS7830, ConfigImage *pImage );
+static int ApplyConfig( ADS7830 *pADS7830, ConfigImage *pImage );
+static size_t GetArenaSize( Config *pConfig );
+static const float *CopyTable( Arena *pArena, const float *pTable );
+static int ApplyChannel( ADS7830 *pADS7830, int channel, AIN *pNew );
+static void SetConversion( ADS7830 *pADS7830, int channel, AIN *pNew );
+static void SetInput( ADS7830 *pADS7830, int channel, AIN *pNew );
+static int SetInterval( ADS7830 *pADS7830, int channel, int interval );
+static void SetAdaptive( ADS7830 *pADS7830, int channel, AIN *pNew );
+static void AdaptInterval( AINHot *pHot, int channel, uint16_t previous );
+static int SetAlarm( ADS7830 *pADS7830, int channel, AIN *pNew );
+static char *GetAlarmName( Arena *pArena, Config *pConfig, int channel );
+static int CheckAlarm( ADS7830 *pADS7830, int channel, uint8_t data );
+static int PublishAlarm( ADS7830 *pADS7830, int channel );
+static void SetStats( ADS7830 *pADS7830, int channel, AIN *pNew );
+static void UpdateStats( ADS7830 *pADS7830, int channel, uint8_t data );
+static int PublishStats( ADS7830 *pADS7830, int channel, uint64_t now );
+static int BindControls( ADS7830 *pADS7830, int channel );
+static int HandleControl( ADS7830 *pADS7830, VAR_HANDLE hVar );
+static void ApplyControls( ADS7830 *pADS7830, int channel );
+static int GetIntValue( VarObject *pVar );
+static int ReloadConfig( ADS7830 *pADS7830 );
 static int SetupPrintNotifications( ADS7830 *pADS7830 );
 static int PrintStatus (ADS7830 *pADS7830, int fd );
+static void ApplyRealtime( ADS7830 *pADS7830 );
 
 /*==============================================================================
         Private function definitions
@@ -242,13 +594,12 @@ static int PrintStatus (ADS7830 *pADS7830, int fd );
 void main(int argc, char **argv)
 {
     ADS7830 state;
-    JNode *config;
-    JArray *channels;
+    ConfigImage config;
 
     printf("Starting %s\n", argv[0]);
 
     /* clear the ads7830 state object */
-    memset( &state, 0, sizeof( ADS7830 ) );
+    InitState( &state );
     pADS7830State = &state;
 
     if( argc < 2 )
@@ -263,35 +614,66 @@ void main(int argc, char **argv)
     /* process the command line options */
     ProcessOptions( argc, argv, &state );
 
-    /* process the input file */
-    config = JSON_Process( state.pFileName );
+    if ( ( state.compileOnly == true ) &&
+         ( state.pCacheFile == NULL ) )
+    {
+        fprintf( stderr, "-C requires a cache file (-c)\n" );
+        usage( argv[0] );
+        exit( 1 );
+    }
+
+    if ( state.simulate != 0 )
+    {
+        /* schedule against the simulated clock from the start */
+        CLOCK_Simulate( TIMESTAMP_Now() );
+    }
+
+    /* load the compiled configuration */
+    if ( LoadConfig( &state, &config ) != EOK )
+    {
+        syslog( LOG_ERR, "unable to load %s", state.pFileName );
+        exit( 1 );
+    }
+
+    if ( state.compileOnly == true )
+    {
+        /* the configuration cache has been written */
+        exit( 0 );
+    }
 
+    if ( state.simulate != 0 )
+    {
+        if ( config.pConfig->backend != CONFIG_BACKEND_REPLAY )
+        {
+            /* never flood the real bus with simulated conversions */
+            fprintf( stderr, "-s requires the replay backend\n" );
+            exit( 1 );
+        }
 
-    /* get the configuration array */
-    channels = (JArray *)JSON_Find( config, "channels" );
+        /* keep the live variables out of the simulated run */
+        state.dryRun = true;
+    }
 
     /* get the name of the i2c device to open */
-    state.device = JSON_GetStr( config, "device" );
+    state.device = CONFIG_GetStr( config.pConfig, config.pConfig->device );
 
     /* get the address of the i2c device to open */
-    state.address = strtoul( JSON_GetStr( config, "address" ), NULL, 16 );
+    state.address = config.pConfig->address;
 
     /* open the i2c device for exclusive access */
     if ( state.exclusive )
     {
-        state.fd = open( state.device, O_RDWR );
-        if ( state.fd == -1 )
+        if ( OpenSession( &state, &state.fd ) != EOK )
         {
             syslog( LOG_ERR, "unable to open i2c device" );
             exit( 1 );
         }
     }
 
-    /* output the confguration file */
-    if( state.verbose == true )
+    /* allocate the timeline trace buffer */
+    if ( TRACE_Init( state.traceSize ) != EOK )
     {
-	    JSON_Print(config, stdout, false );
-        printf("\n");
+        syslog( LOG_ERR, "unable to allocate trace buffer" );
     }
 
 
@@ -302,8 +684,11 @@ void main(int argc, char **argv)
         /* set up the print notifications */
         SetupPrintNotifications( &state );
 
-        /* set up the file vars by iterating through the configuration array */
-        JSON_Iterate( channels, ParseChannel, (void *)&state );
+        /* set up the channels from the configuration */
+        ApplyConfig( &state, &config );
+
+        /* apply the real-time profile to the acquisition thread */
+        ApplyRealtime( &state );
 
         /* output the ADS7830 status */
         if( state.output == true )
@@ -311,14 +696,50 @@ void main(int argc, char **argv)
             PrintStatus( &state, STDOUT_FILENO );
         }
 
-        /* run the ADS7830 controller */
-        run( &state );
+        if ( state.simulate != 0 )
+        {
+            /* fast-forward the scheduler and report how it kept up */
+            Simulate( &state );
+            PrintStatus( &state, STDOUT_FILENO );
+        }
+        else
+        {
+            /* run the ADS7830 controller */
+            run( &state );
+        }
 
         /* close the variable server */
         VARSERVER_Close( state.hVarServer );
     }
 }
 
+/*============================================================================*/
+/*  InitState                                                                 */
+/*!
+    Initialize the ADS7830 state object
+
+    The InitState function clears the ADS7830 state object and marks
+    all of its file descriptors as closed.
+
+    @param[in,out]
+        pADS7830
+            pointer to the ADS7830 state object to initialize
+
+==============================================================================*/
+static void InitState( ADS7830 *pADS7830 )
+{
+    int ch;
+
+    memset( pADS7830, 0, sizeof( ADS7830 ) );
+    pADS7830->pFlightFile = FLIGHT_DUMP_FILE;
+    pADS7830->fd = -1;
+    pADS7830->busRetries = -1;
+    for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+    {
+        pADS7830->sysfsFd[ch] = -1;
+    }
+}
+
 /*============================================================================*/
 /*  usage                                                                     */
 /*!
@@ -339,9 +760,21 @@ static void usage( char *cmdname )
     if( cmdname != NULL )
     {
         fprintf(stderr,
-                "usage: %s [-v] [-h] [<filename>]\n"
+                "usage: %s [-v] [-h] [-o] [-t <events>] [-f <dumpfile>] "
+                "[-c <cachefile>] [-C] [-p <priority>] [-m] [-a <mask>] "
+                "[-s <seconds>] [<filename>]\n"
                 " [-h] : display this help\n"
+                " [-c] : compiled configuration cache file\n"
+                " [-C] : compile the configuration cache file and exit\n"
                 " [-o] : output the configuration\n"
+                " [-f] : flight recorder dump file (default "
+                FLIGHT_DUMP_FILE ")\n"
+                " [-t] : size of the timeline trace buffer in events\n"
+                " [-p] : run the acquisition thread at a SCHED_FIFO priority\n"
+                " [-m] : lock memory and prefault the stack\n"
+                " [-a] : acquisition thread CPU affinity mask\n"
+                " [-s] : dry run the replay schedule for a number of "
+                "seconds and exit\n"
                 " [-v] : verbose output\n",
                 cmdname );
     }
@@ -377,7 +810,7 @@ static int ProcessOptions( int argC,
 {
     int c;
     int result = EINVAL;
-    const char *options = "hvo";
+    const char *options = "hvot:f:c:Cp:ma:s:";
 
     if( ( pADS7830 != NULL ) &&
         ( argV != NULL ) )
@@ -394,6 +827,38 @@ static int ProcessOptions( int argC,
                     pADS7830->output = true;
                     break;
 
+                case 't':
+                    pADS7830->traceSize = strtoul( optarg, NULL, 0 );
+                    break;
+
+                case 'f':
+                    pADS7830->pFlightFile = optarg;
+                    break;
+
+                case 'c':
+                    pADS7830->pCacheFile = optarg;
+                    break;
+
+                case 'C':
+                    pADS7830->compileOnly = true;
+                    break;
+
+                case 'p':
+                    pADS7830->rt.priority = atoi( optarg );
+                    break;
+
+                case 'm':
+                    pADS7830->rt.lock = true;
+                    break;
+
+                case 'a':
+                    pADS7830->rt.affinity = strtoull( optarg, NULL, 0 );
+                    break;
+
+                case 's':
+                    pADS7830->simulate = strtoull( optarg, NULL, 0 );
+                    break;
+
                 case 'h':
                     usage( argV[0] );
                     break;
@@ -482,7 +947,12 @@ static void TerminationHandler( int signum, siginfo_t *info, void *ptr )
     Run the ADS7830 controller
 
     The run function loops forever waiting for signals from the
-    variable server or timer events.
+    variable server or the next channel sample deadline.
+
+    On-demand (CALC) requests are serviced ahead of periodic samples,
+    but once ADS7830_INTERACTIVE_BURST on-demand samples have been taken
+    back to back, any overdue periodic samples are taken before the
+    next wait so the periodic channels cannot be starved.
 
     @param[in]
         pADS7830
@@ -505,14 +975,121 @@ static int run( ADS7830 *pADS7830 )
 
         while( pADS7830->running == true )
         {
-            WaitSignal( &signum, &id );
+            WaitSignal( &signum, &id, GetTimeout( pADS7830 ) );
             HandleSignal( pADS7830, signum, id );
+
+            if ( pADS7830->interactiveRun >= ADS7830_INTERACTIVE_BURST )
+            {
+                /* starvation protection for the periodic channels */
+                ServiceDeadlines( pADS7830 );
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/*============================================================================*/
+/*  Simulate                                                                  */
+/*!
+    Run the ADS7830 scheduler against the simulated clock
+
+    The Simulate function runs the sample scheduler for the simulated
+    run time.  Instead of waiting for the next sample deadline, the
+    simulated clock skips straight to it, and each conversion advances
+    the clock by ADS7830_SIM_CONVERSION.  The bus budget, statistics
+    publication and device health backoff follow the simulated clock,
+    so a day of multi-rate sampling runs in seconds.  Signals are not
+    serviced during the simulated run.
+
+    The simulated run only reads from a recording with the replay
+    backend, since a device backend would issue every simulated
+    conversion to the real bus as fast as the CPU allows.  The run is
+    a dry run: no variables are set on the variable server.
+
+    The deadline accuracy and overrun counts are reported in the
+    ADS7830 status.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @retval EOK the simulated run completed
+    @retval ENOTSUP the backend is not the replay backend
+    @retval EINVAL invalid arguments or the simulated clock is not in use
+
+==============================================================================*/
+static int Simulate( ADS7830 *pADS7830 )
+{
+    int result = EINVAL;
+    uint64_t start;
+
+    if ( ( pADS7830 != NULL ) &&
+         ( CLOCK_IsSimulated() == true ) )
+    {
+        if ( pADS7830->backend != CONFIG_BACKEND_REPLAY )
+        {
+            syslog( LOG_ERR, "simulation requires the replay backend" );
+            result = ENOTSUP;
+        }
+        else
+        {
+            result = EOK;
+            start = TIMESTAMP_Now();
+            pADS7830->dryRun = true;
+
+            RunSchedule( pADS7830, pADS7830->simulate * 1000000ULL );
+
+            pADS7830->simElapsed = TIMESTAMP_Now() - start;
+
+            syslog( LOG_INFO,
+                    "simulated %llu s in %llu us",
+                    (unsigned long long)pADS7830->simulate,
+                    (unsigned long long)pADS7830->simElapsed );
         }
     }
 
     return result;
 }
 
+/*============================================================================*/
+/*  RunSchedule                                                               */
+/*!
+    Run the sample schedule on the simulated clock
+
+    The RunSchedule function services the sample deadlines for a
+    simulated duration, skipping the wait before each deadline.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        duration
+            simulated time to run for in microseconds
+
+==============================================================================*/
+static void RunSchedule( ADS7830 *pADS7830, uint64_t duration )
+{
+    uint64_t end = CLOCK_Now() + duration;
+    int64_t timeout;
+
+    timeout = GetTimeout( pADS7830 );
+    while ( ( timeout >= 0 ) &&
+            ( CLOCK_Now() + (uint64_t)timeout <= end ) )
+    {
+        /* skip the wait for the next deadline */
+        CLOCK_Advance( (uint64_t)timeout );
+        ServiceDeadlines( pADS7830 );
+        timeout = GetTimeout( pADS7830 );
+    }
+
+    if ( CLOCK_Now() < end )
+    {
+        CLOCK_Advance( end - CLOCK_Now() );
+    }
+}
 
 /*============================================================================*/
 /*  WaitSignal                                                                */
@@ -520,7 +1097,8 @@ static int run( ADS7830 *pADS7830 )
     Wait for a signal from the system
 
     The WaitSignal function waits for either a variable calculation request
-    or timer expired signal from the system
+    or another signal from the system, or for the next sample deadline.
+    If the wait times out, TIMER_NOTIFICATION is returned as the signal.
 
 @param[in,out]
     signum
@@ -530,14 +1108,19 @@ static int run( ADS7830 *pADS7830 )
     id
         Pointer to a location to store the signal identifier
 
+@param[in]
+    timeout
+        maximum time to wait in microseconds, or -1 to wait forever
+
 @retval 0 signal received successfully
 @retval -1 an error occurred
 
 ==============================================================================*/
-static int WaitSignal( int *signum, int *id )
+static int WaitSignal( int *signum, int *id, int64_t timeout )
 {
     sigset_t mask;
     siginfo_t info;
+    struct timespec ts;
     int result = EINVAL;
     int sig;
 
@@ -547,20 +1130,45 @@ static int WaitSignal( int *signum, int *id )
         /* create an empty signal set */
         sigemptyset( &mask );
 
-        /* timer notification */
-        sigaddset( &mask, TIMER_NOTIFICATION );
-
         /* calc notification */
         sigaddset( &mask, SIG_VAR_CALC );
 
+        /* modified notification */
+        sigaddset( &mask, SIG_VAR_MODIFIED );
+
         /* print notification */
         sigaddset( &mask, SIG_VAR_PRINT );
 
+        /* flight recorder dump notification */
+        sigaddset( &mask, FLIGHT_NOTIFICATION );
+
+        /* configuration reload notification */
+        sigaddset( &mask, RELOAD_NOTIFICATION );
+
         /* apply signal mask */
         sigprocmask( SIG_BLOCK, &mask, NULL );
 
-        /* wait for the signal */
-        sig = sigwaitinfo( &mask, &info );
+        /* wait for the signal or the next sample deadline */
+        memset( &info, 0, sizeof( info ) );
+        if ( timeout >= 0 )
+        {
+            ts.tv_sec = timeout / 1000000;
+            ts.tv_nsec = ( timeout % 1000000 ) * 1000;
+            sig = sigtimedwait( &mask, &info, &ts );
+            if ( ( sig == -1 ) && ( errno == EAGAIN ) )
+            {
+                sig = TIMER_NOTIFICATION;
+                info._sifields._timer.si_sigval.sival_int = -1;
+            }
+        }
+        else
+        {
+            sig = sigwaitinfo( &mask, &info );
+        }
+
+        ADS7830_PROBE2( wait_wakeup,
+                        sig,
+                        info._sifields._timer.si_sigval.sival_int );
 
         /* return the signal information */
         *signum = sig;
@@ -574,85 +1182,552 @@ static int WaitSignal( int *signum, int *id )
 }
 
 /*============================================================================*/
-/*  HandleSignal                                                              */
+/*  GetTimeout                                                                */
 /*!
-    Handle Received Signals
+    Get the time until the next sample deadline
 
-    The HandleSignal function handles signals received from the system,
-    such as one of the following:
-        - SIG_VAR_CALC
-        - SIG_VAR_PRINT
-        - TIMER_NOTIFICATION
+    The GetTimeout function scans the channel deadlines, the packed
+    scan deadline, and the time the next recorded sample of a paced
+    replay is due, to find the time remaining until the next one.
 
     @param[in]
         pADS7830
             pointer to the ADS7830 controller state object
 
-    @param[in]
-        signum
-            the number of the received signal. One of:
-            SIG_VAR_CALC
-            SIG_VAR_PRINT
-            TIMER_NOTIFICATION
-
-
-    @retval EOK the signal was handled successfully
-    @retval ENOTSUP the signal was not supported
-    @retval ENOENT the channel was invalid
-    @retval EINVAL invalid arguments
+    @retval time until the next deadline in microseconds
+    @retval -1 if no channel is scheduled
 
 ==============================================================================*/
-static int HandleSignal( ADS7830 *pADS7830, int signum, int id )
+static int64_t GetTimeout( ADS7830 *pADS7830 )
 {
-    int sig;
-    VAR_HANDLE hVar;
-    int fd = -1;
-    int result = EINVAL;
+    int64_t timeout = -1;
+    uint64_t next = 0;
+    uint64_t deadline;
+    uint64_t now;
     int ch;
 
     if ( pADS7830 != NULL )
     {
-        if( sig == SIG_VAR_CALC )
+        for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
         {
-            /* get a handle to the ADC channel associated with
-             * the specified variable */
-            hVar = (VAR_HANDLE)id;
-            ch = FindChannel( pADS7830, hVar );
-            if ( ( ch >= 0 ) && ( ch < ADS7830_NUM_CHANNELS ) )
+            deadline = pADS7830->hot.deadline[ch];
+            if ( ( deadline != 0 ) &&
+                 ( ( next == 0 ) || ( deadline < next ) ) )
             {
-                /* sample the ADC channel */
-                result = SampleChannel( pADS7830, ch );
-            }
-            else
-            {
-                /* invalid channel number */
-                result = ENOENT;
+                next = deadline;
             }
         }
-        else if ( sig == SIG_VAR_PRINT )
+
+        deadline = pADS7830->hot.scanDeadline;
+        if ( ( deadline != 0 ) &&
+             ( ( next == 0 ) || ( deadline < next ) ) )
         {
-            /* open a print session */
-            VAR_OpenPrintSession( pADS7830->hVarServer,
-                                  id,
-                                  &hVar,
-                                  &fd );
+            next = deadline;
+        }
 
-            /* print the file variable */
-            PrintStatus( pADS7830, fd );
+        deadline = ( pADS7830->backend == CONFIG_BACKEND_REPLAY )
+                   ? REPLAY_Due( &pADS7830->replay )
+                   : 0;
+        if ( ( deadline != 0 ) &&
+             ( ( next == 0 ) || ( deadline < next ) ) )
+        {
+            next = deadline;
+        }
 
-            /* Close the print session */
-            VAR_ClosePrintSession( pADS7830->hVarServer,
-                                   id,
-                                   fd );
+        if ( next != 0 )
+        {
+            now = CLOCK_Now();
+            timeout = ( next > now ) ? (int64_t)( next - now ) : 0;
+        }
+    }
 
-            result = EOK;
+    return timeout;
+}
+
+/*============================================================================*/
+/*  ServiceDeadlines                                                          */
+/*!
+    Sample the channels which are due
+
+    The ServiceDeadlines function samples every channel whose sample
+    deadline has passed, earliest deadline first, and advances its
+    deadline by its sample period.  If a channel has fallen more than
+    a full period behind, the missed samples are skipped rather than
+    sampled back to back.  The periods of adaptive channels are adjusted
+    after each sample before the next deadline is set.
+
+    Pending on-demand requests are serviced before each periodic sample,
+    so an on-demand request waits for at most one periodic bus
+    transaction rather than a full scan.
+
+    The lateness of each periodic sample against its deadline, and the
+    number of times a channel falls a full period behind, are counted
+    to report the deadline accuracy.
+
+    Periodic samples which would exceed the bus transaction budget are
+    either dropped (the channel moves on to its next deadline) or
+    stretched (the sample is delayed until the budget allows it),
+    depending on the budget policy.
+
+    With a paced replay, the recorded samples which are due are played
+    through their channels first.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @retval EOK the due channels were sampled
+    @retval EINVAL invalid arguments
+    @retval other error from SampleChannel
+
+==============================================================================*/
+static int ServiceDeadlines( ADS7830 *pADS7830 )
+{
+    int result = EINVAL;
+    AINHot *pHot;
+    uint64_t now;
+    uint64_t start;
+    uint64_t late;
+    uint16_t previous;
+    int ch;
+    int i;
+    int rc;
+
+    if ( pADS7830 != NULL )
+    {
+        result = EOK;
+        pHot = &pADS7830->hot;
+        now = CLOCK_Now();
+
+        if ( pADS7830->backend == CONFIG_BACKEND_REPLAY )
+        {
+            /* play the recorded samples which are due */
+            rc = ServiceReplay( pADS7830, now );
+            if ( rc != EOK )
+            {
+                result = rc;
+            }
         }
-        else if ( sig == TIMER_NOTIFICATION )
+
+        do
+        {
+            /* find the most overdue channel */
+            ch = -1;
+            for ( i = 0; i < ADS7830_NUM_CHANNELS; i++ )
+            {
+                if ( ( pHot->deadline[i] != 0 ) &&
+                     ( pHot->deadline[i] <= now ) &&
+                     ( ( ch == -1 ) ||
+                       ( pHot->deadline[i] < pHot->deadline[ch] ) ) )
+                {
+                    ch = i;
+                }
+            }
+
+            if ( ch != -1 )
+            {
+                /* on-demand requests go first */
+                ServiceInteractive( pADS7830 );
+                if ( pADS7830->interactiveRun >= ADS7830_INTERACTIVE_BURST )
+                {
+                    pADS7830->starvationGuards++;
+                }
+
+                pADS7830->interactiveRun = 0;
+
+                if ( BUCKET_Take( &pADS7830->budget, 1, now ) == true )
+                {
+                    start = TRACE_Begin();
+                    previous = pHot->value[ch];
+
+                    /* measure the deadline accuracy */
+                    late = CLOCK_Now() - pHot->deadline[ch];
+                    pADS7830->lateTotal += late;
+                    if ( late > pADS7830->lateMax )
+                    {
+                        pADS7830->lateMax = late;
+                    }
+
+                    pADS7830->scheduled++;
+
+                    /* sample the ADC channel */
+                    rc = SampleChannel( pADS7830, ch );
+                    if ( rc != EOK )
+                    {
+                        result = rc;
+                    }
+                    else if ( pHot->maxPeriod[ch] != 0 )
+                    {
+                        /* follow the signal activity */
+                        AdaptInterval( pHot, ch, previous );
+                    }
+
+                    /* schedule the next sample */
+                    pHot->deadline[ch] += pHot->period[ch];
+                    if ( pHot->deadline[ch] <= now )
+                    {
+                        pHot->deadline[ch] = now + pHot->period[ch];
+                        pADS7830->overruns++;
+                    }
+
+                    TRACE_End( TRACE_EVENT_TIMER, ch, start );
+                }
+                else if ( pADS7830->budgetPolicy == CONFIG_BUDGET_STRETCH )
+                {
+                    /* retry the sample when the budget allows it */
+                    pHot->deadline[ch] = now + 1
+                                         + BUCKET_Delay( &pADS7830->budget,
+                                                         1,
+                                                         now );
+                    pADS7830->budgetStretched++;
+                }
+                else
+                {
+                    /* skip this sample */
+                    pHot->deadline[ch] += pHot->period[ch];
+                    if ( pHot->deadline[ch] <= now )
+                    {
+                        pHot->deadline[ch] = now + pHot->period[ch];
+                    }
+
+                    pADS7830->budgetDropped++;
+                }
+            }
+        } while ( ch != -1 );
+
+        if ( ( pHot->scanDeadline != 0 ) &&
+             ( pHot->scanDeadline <= now ) )
+        {
+            /* publish the packed scan */
+            ServiceInteractive( pADS7830 );
+            rc = ServiceScan( pADS7830, now );
+            if ( rc != EOK )
+            {
+                result = rc;
+            }
+        }
+
+        pADS7830->interactiveRun = 0;
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ServiceScan                                                               */
+/*!
+    Publish a packed scan of all channels
+
+    The ServiceScan function samples every enabled channel which has a
+    variable configured, back to back, and publishes all the channel
+    values with a single VAR_Set to the packed scan variable as a
+    compact string:
+
+        <timestamp>,<A0>,<A1>,<A2>,<A3>,<A4>,<A5>,<A6>,<A7>
+
+    where the timestamp is the scheduler time of the scan in
+    microseconds, and each channel value is in counts.  Channels which
+    were not sampled are left empty.  The scan is subject to the bus
+    transaction budget as a whole.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+    @retval EOK the scan was published (or deferred by the budget)
+    @retval other error from VAR_Set
+
+==============================================================================*/
+static int ServiceScan( ADS7830 *pADS7830, uint64_t now )
+{
+    int result = EOK;
+    AINHot *pHot = &pADS7830->hot;
+    AIN *pAIN;
+    char buf[ADS7830_SCAN_LEN];
+    VarObject var;
+    uint64_t start;
+    uint64_t scanTime;
+    uint32_t count = 0;
+    int channels[ADS7830_NUM_CHANNELS];
+    uint8_t data[ADS7830_NUM_CHANNELS];
+    int rc[ADS7830_NUM_CHANNELS];
+    size_t len;
+    uint32_t i = 0;
+    int ch;
+
+    for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+    {
+        pAIN = &pADS7830->channels[ch];
+        if ( ( pAIN->name != NULL ) && ( pAIN->disabled == false ) )
+        {
+            channels[count++] = ch;
+        }
+    }
+
+    if ( BUCKET_Take( &pADS7830->budget, count, now ) == true )
+    {
+        start = TRACE_Begin();
+        scanTime = CLOCK_Now();
+
+        len = snprintf( buf,
+                        sizeof( buf ),
+                        "%llu",
+                        (unsigned long long)scanTime );
+
+        /* read the channels back to back */
+        ReadChannels( pADS7830, channels, count, data, rc );
+
+        for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+        {
+            if ( ( i < count ) && ( channels[i] == ch ) )
+            {
+                if ( rc[i] == EOK )
+                {
+                    pHot->value[ch] = data[i];
+                    pHot->timestamp[ch] = scanTime;
+                }
+
+                FLIGHT_Record( scanTime,
+                               ch,
+                               data[i],
+                               rc[i],
+                               (uint32_t)( CLOCK_Now() - scanTime ) );
+
+                len += snprintf( &buf[len],
+                                 sizeof( buf ) - len,
+                                 ( rc[i] == EOK ) ? ",%u" : ",",
+                                 data[i] );
+                i++;
+            }
+            else
+            {
+                /* the channel is not part of the scan */
+                len += snprintf( &buf[len], sizeof( buf ) - len, "," );
+            }
+        }
+
+        var.type = VARTYPE_STR;
+        var.val.str = buf;
+        var.len = len + 1;
+
+        result = SetVar( pADS7830, pADS7830->hScan, &var );
+
+        /* schedule the next scan */
+        pHot->scanDeadline += pHot->scanPeriod;
+        if ( pHot->scanDeadline <= now )
+        {
+            pHot->scanDeadline = now + pHot->scanPeriod;
+        }
+
+        TRACE_End( TRACE_EVENT_SCAN, -1, start );
+    }
+    else if ( pADS7830->budgetPolicy == CONFIG_BUDGET_STRETCH )
+    {
+        /* retry the scan when the budget allows it */
+        pHot->scanDeadline = now + 1
+                             + BUCKET_Delay( &pADS7830->budget, count, now );
+        pADS7830->budgetStretched++;
+    }
+    else
+    {
+        /* skip this scan */
+        pHot->scanDeadline += pHot->scanPeriod;
+        if ( pHot->scanDeadline <= now )
+        {
+            pHot->scanDeadline = now + pHot->scanPeriod;
+        }
+
+        pADS7830->budgetDropped++;
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  SetScan                                                                   */
+/*!
+    Set up the packed scan
+
+    The SetScan function binds the packed scan variable from the
+    configuration and schedules the first scan.  The packed scan is
+    not scheduled if the variable does not exist.  If the variable
+    name and interval are unchanged by a reload, the live binding and
+    deadline are kept so the scan carries on without a gap.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+    @param[in]
+        pArena
+            pointer to the new runtime state arena
+
+==============================================================================*/
+static void SetScan( ADS7830 *pADS7830, Config *pConfig, Arena *pArena )
+{
+    char *name;
+    uint64_t period;
+    bool changed;
+
+    name = ARENA_StrDup( pArena, CONFIG_GetStr( pConfig, pConfig->scanVar ) );
+    period = (uint64_t)pConfig->scanInterval * 1000;
+
+    if ( ( pADS7830->scanName != NULL ) && ( name != NULL ) )
+    {
+        changed = ( strcmp( pADS7830->scanName, name ) != 0 );
+    }
+    else
+    {
+        changed = ( pADS7830->scanName != name );
+    }
+
+    changed = changed || ( pADS7830->hot.scanPeriod != period );
+
+    /* the name always refers to the current configuration */
+    pADS7830->scanName = name;
+
+    if ( changed == true )
+    {
+        pADS7830->hScan = ( name != NULL )
+                          ? VAR_FindByName( pADS7830->hVarServer, name )
+                          : VAR_INVALID;
+
+        pADS7830->hot.scanPeriod = period;
+        pADS7830->hot.scanDeadline = ( pADS7830->hScan != VAR_INVALID )
+                        ? CLOCK_Now() + pADS7830->hot.scanPeriod
+                        : 0;
+    }
+}
+
+/*============================================================================*/
+/*  ServiceInteractive                                                        */
+/*!
+    Service pending on-demand sample requests
+
+    The ServiceInteractive function takes the CALC requests which are
+    already pending, without waiting, until ADS7830_INTERACTIVE_BURST
+    on-demand samples have been taken since the last periodic sample.
+    It is called ahead of each periodic sample to give on-demand
+    requests priority on the bus.
+
+    No requests are taken on the simulated clock, so a simulated run
+    stays deterministic and never services the live variable server.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @retval EOK the pending requests were serviced
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+static int ServiceInteractive( ADS7830 *pADS7830 )
+{
+    int result = EINVAL;
+    sigset_t mask;
+    siginfo_t info;
+    struct timespec ts;
+    int sig;
+
+    if ( pADS7830 != NULL )
+    {
+        result = EOK;
+
+        sigemptyset( &mask );
+        sigaddset( &mask, SIG_VAR_CALC );
+        ts.tv_sec = 0;
+        ts.tv_nsec = 0;
+
+        while ( ( CLOCK_IsSimulated() == false ) &&
+                ( pADS7830->interactiveRun < ADS7830_INTERACTIVE_BURST ) )
+        {
+            memset( &info, 0, sizeof( info ) );
+            sig = sigtimedwait( &mask, &info, &ts );
+            if ( sig != SIG_VAR_CALC )
+            {
+                break;
+            }
+
+            HandleSignal( pADS7830,
+                          sig,
+                          info._sifields._timer.si_sigval.sival_int );
+
+            pADS7830->preemptions++;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  HandleSignal                                                              */
+/*!
+    Handle Received Signals
+
+    The HandleSignal function handles signals received from the system,
+    such as one of the following:
+        - SIG_VAR_CALC
+        - SIG_VAR_MODIFIED
+        - SIG_VAR_PRINT
+        - TIMER_NOTIFICATION
+        - FLIGHT_NOTIFICATION
+        - RELOAD_NOTIFICATION
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        signum
+            the number of the received signal. One of:
+            SIG_VAR_CALC
+            SIG_VAR_MODIFIED
+            SIG_VAR_PRINT
+            TIMER_NOTIFICATION
+            FLIGHT_NOTIFICATION
+            RELOAD_NOTIFICATION
+
+
+    @retval EOK the signal was handled successfully
+    @retval ENOTSUP the signal was not supported
+    @retval ENOENT the channel was invalid
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+static int HandleSignal( ADS7830 *pADS7830, int signum, int id )
+{
+    int sig = signum;
+    VAR_HANDLE hVar;
+    int fd = -1;
+    int result = EINVAL;
+    int ch = -1;
+    uint64_t start;
+
+    if ( pADS7830 != NULL )
+    {
+        ADS7830_PROBE2( signal_dispatch, sig, id );
+
+        start = TRACE_Begin();
+
+        if( sig == SIG_VAR_CALC )
         {
-            /* Handle a timer notification */
-            ch = id;
+            /* get a handle to the ADC channel associated with
+             * the specified variable */
+            hVar = (VAR_HANDLE)id;
+            ch = FindChannel( pADS7830, hVar );
             if ( ( ch >= 0 ) && ( ch < ADS7830_NUM_CHANNELS ) )
             {
+                /* on-demand samples are never refused by the budget */
+                BUCKET_Charge( &pADS7830->budget, CLOCK_Now() );
+
                 /* sample the ADC channel */
                 result = SampleChannel( pADS7830, ch );
             }
@@ -661,65 +1736,2518 @@ static int HandleSignal( ADS7830 *pADS7830, int signum, int id )
                 /* invalid channel number */
                 result = ENOENT;
             }
+
+            pADS7830->interactiveRun++;
+
+            TRACE_End( TRACE_EVENT_CALC, ch, start );
         }
-        else
+        else if ( sig == SIG_VAR_MODIFIED )
         {
-            /* unsupported notification type */
-            result = ENOTSUP;
+            /* apply a channel control change */
+            result = HandleControl( pADS7830, (VAR_HANDLE)id );
         }
+        else if ( sig == SIG_VAR_PRINT )
+        {
+            /* open a print session */
+            VAR_OpenPrintSession( pADS7830->hVarServer,
+                                  id,
+                                  &hVar,
+                                  &fd );
+
+            if ( ( hVar != VAR_INVALID ) &&
+                 ( hVar == pADS7830->hTrace ) )
+            {
+                /* dump the timeline trace */
+                TRACE_Dump( fd );
+            }
+            else if ( ( hVar != VAR_INVALID ) &&
+                      ( hVar == pADS7830->hFlight ) )
+            {
+                /* dump the flight recorder */
+                FLIGHT_Dump( fd );
+            }
+            else
+            {
+                /* print the ADS7830 status */
+                PrintStatus( pADS7830, fd );
+            }
+
+            /* Close the print session */
+            VAR_ClosePrintSession( pADS7830->hVarServer,
+                                   id,
+                                   fd );
+
+            TRACE_End( TRACE_EVENT_PRINT, -1, start );
+
+            result = EOK;
+        }
+        else if ( sig == TIMER_NOTIFICATION )
+        {
+            /* sample the channels which are due */
+            result = ServiceDeadlines( pADS7830 );
+        }
+        else if ( sig == FLIGHT_NOTIFICATION )
+        {
+            /* dump the flight recorder to the dump file */
+            fd = open( pADS7830->pFlightFile,
+                       O_WRONLY | O_CREAT | O_TRUNC,
+                       0644 );
+            if ( fd != -1 )
+            {
+                result = FLIGHT_Dump( fd );
+                close( fd );
+            }
+            else
+            {
+                result = errno;
+                syslog( LOG_ERR,
+                        "unable to open %s",
+                        pADS7830->pFlightFile );
+            }
+        }
+        else if ( sig == RELOAD_NOTIFICATION )
+        {
+            /* reload the configuration file */
+            result = ReloadConfig( pADS7830 );
+        }
+        else
+        {
+            /* unsupported notification type */
+            result = ENOTSUP;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  FindChannel                                                               */
+/*!
+    Find an ADC channel
+
+    The FindChannnel function finds the ADC channel associated with the
+    specified variable handle.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        hVar
+            handle to a variable associated with an ADC channel
+
+    @retval channel id in the range [0..ADS7830_NUM_CHANNELS]
+    @retval -1 if the channel is not found
+
+==============================================================================*/
+static int FindChannel( ADS7830 *pADS7830, VAR_HANDLE hVar )
+{
+    int channel = -1;
+    int i;
+
+    if( ( pADS7830 != NULL ) &&
+        ( hVar != VAR_INVALID ) )
+    {
+        for( i = 0; i < ADS7830_NUM_CHANNELS; i ++ )
+        {
+            if( pADS7830->channels[i].hVar == hVar )
+            {
+                channel = i;
+                break;
+            }
+        }
+    }
+
+    return channel;
+}
+
+/*============================================================================*/
+/*  SampleChannel                                                             */
+/*!
+    Sample the specified ADC channel
+
+    The SampleChannel function samples the specified ADC channel and writes
+    the result to the system variable associated with that channel
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to sample [0..7]
+
+    @retval EOK the channel was sampled successfully
+    @retval EINVAL invalid arguments
+    @retval ENOTSUP sampling is disabled for the channel
+    @retval other error from open, iotctl, or SetVar functions
+
+==============================================================================*/
+static int SampleChannel( ADS7830 *pADS7830, int channel )
+{
+    int result = EINVAL;
+    uint8_t data = 0;
+    VarObject var;
+    VAR_HANDLE hVar;
+    uint64_t start;
+    uint64_t sampleTime;
+
+    if ( ( pADS7830 != NULL ) &&
+         ( channel >= 0 ) &&
+         ( channel < ADS7830_NUM_CHANNELS ) )
+    {
+        /* get the system variable handle for the channel */
+        hVar = pADS7830->channels[channel].hVar;
+        if ( pADS7830->channels[channel].disabled == true )
+        {
+            /* sampling is disabled for this channel */
+            result = ENOTSUP;
+        }
+        else if ( hVar != VAR_INVALID )
+        {
+            sampleTime = CLOCK_Now();
+
+            result = ReadChannel( pADS7830, channel, &data );
+            if ( result == EOK )
+            {
+                /* update the hot channel state */
+                pADS7830->hot.value[channel] = data;
+                pADS7830->hot.timestamp[channel] = sampleTime;
+
+                /* populate the variable data */
+                ConvertSample( pADS7830, channel, data, &var );
+
+                ADS7830_PROBE3( var_set_start, channel, hVar, data );
+                start = TRACE_Begin();
+
+                /* set the variable value */
+                result = SetVar( pADS7830, hVar, &var );
+
+                TRACE_End( TRACE_EVENT_VARSET, channel, start );
+
+                ADS7830_PROBE4( var_set_end, channel, hVar, data, result );
+
+                if ( pADS7830->channels[channel].hAlarm != VAR_INVALID )
+                {
+                    /* evaluate the channel alarm */
+                    CheckAlarm( pADS7830, channel, data );
+                }
+
+                if ( pADS7830->channels[channel].stats.capacity != 0 )
+                {
+                    /* update the rolling window statistics */
+                    UpdateStats( pADS7830, channel, data );
+                }
+            }
+
+            /* record the acquisition in the flight recorder */
+            FLIGHT_Record( sampleTime,
+                           channel,
+                           data,
+                           result,
+                           (uint32_t)( CLOCK_Now() - sampleTime ) );
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ConvertSample                                                             */
+/*!
+    Convert a sample for publication
+
+    The ConvertSample function converts an ADC sample into the format
+    published to the channel variable.  Float variables receive the
+    value in engineering units.  Integer variables receive the value
+    in engineering units as a fixed-point number if the channel has
+    a "decimals" setting, or the raw counts otherwise.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the sampled channel [0..7]
+
+    @param[in]
+        data
+            the ADC sample in counts
+
+    @param[in,out]
+        pVar
+            pointer to the variable object to populate
+
+==============================================================================*/
+static void ConvertSample( ADS7830 *pADS7830,
+                           int channel,
+                           uint8_t data,
+                           VarObject *pVar )
+{
+    AINHot *pHot = &pADS7830->hot;
+    float eng;
+    double fixed;
+
+    eng = ToEngineering( pHot, channel, data );
+
+    if ( pHot->type[channel] == VARTYPE_FLOAT )
+    {
+        pVar->type = VARTYPE_FLOAT;
+        pVar->len = sizeof(float);
+        pVar->val.f = eng;
+    }
+    else if ( pHot->fixed[channel] != 0.0f )
+    {
+        /* values outside the range of the variable type saturate */
+        fixed = (double)eng * pHot->fixed[channel];
+        pVar->type = pHot->type[channel];
+
+        switch( pHot->type[channel] )
+        {
+            case VARTYPE_INT16:
+                pVar->len = sizeof(int16_t);
+                pVar->val.i = ToFixed( fixed, INT16_MIN, INT16_MAX );
+                break;
+
+            case VARTYPE_UINT32:
+                pVar->len = sizeof(uint32_t);
+                pVar->val.ul = ToFixed( fixed, 0, UINT32_MAX );
+                break;
+
+            case VARTYPE_INT32:
+                pVar->len = sizeof(int32_t);
+                pVar->val.l = ToFixed( fixed, INT32_MIN, INT32_MAX );
+                break;
+
+            default:
+                pVar->type = VARTYPE_UINT16;
+                pVar->len = sizeof(uint16_t);
+                pVar->val.ui = ToFixed( fixed, 0, UINT16_MAX );
+                break;
+        }
+    }
+    else
+    {
+        pVar->type = VARTYPE_UINT16;
+        pVar->len = sizeof(uint16_t);
+        pVar->val.ui = data;
+    }
+}
+
+/*============================================================================*/
+/*  ToEngineering                                                             */
+/*!
+    Convert a sample to engineering units
+
+    The ToEngineering function converts an ADC sample to engineering
+    units with a single lookup in the channel's conversion table, or
+    with the channel's linear conversion if it has no table.
+
+    @param[in]
+        pHot
+            pointer to the hot channel state
+
+    @param[in]
+        channel
+            the id of the sampled channel [0..7]
+
+    @param[in]
+        data
+            the ADC sample in counts
+
+    @retval the sample in engineering units
+
+==============================================================================*/
+static float ToEngineering( AINHot *pHot, int channel, uint8_t data )
+{
+    const float *lut = pHot->lut[channel];
+
+    return ( lut != NULL ) ? lut[data]
+                           : ( data * pHot->gain[channel] )
+                             + pHot->offset[channel];
+}
+
+/*============================================================================*/
+/*  ToFixed                                                                   */
+/*!
+    Round a fixed-point value into the range of its variable type
+
+    The ToFixed function rounds a scaled engineering value to the
+    nearest integer, saturating at the limits of the variable type.
+    Values which are not a number map to the minimum.
+
+    @param[in]
+        value
+            the scaled engineering value
+
+    @param[in]
+        min
+            the minimum value of the variable type
+
+    @param[in]
+        max
+            the maximum value of the variable type
+
+    @retval the rounded and saturated value
+
+==============================================================================*/
+static long long ToFixed( double value, double min, double max )
+{
+    long long result;
+
+    if ( !( value > min ) )
+    {
+        result = (long long)min;
+    }
+    else if ( value >= max )
+    {
+        result = (long long)max;
+    }
+    else
+    {
+        result = llrint( value );
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ReadChannel                                                               */
+/*!
+    Read the specified ADC channel
+
+    The ReadChannel function reads the specified ADC channel and puts
+    the value in the location pointed to by 'data'
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to sample [0..7]
+
+    @param[in,out]
+        data
+            pointer to a uint8_t location to store the ADC data
+
+    The device is not accessed while it is being backed off after
+    a failure (see UpdateHealth).
+
+    @retval EOK the channel was read successfully
+    @retval EINVAL invalid arguments
+    @retval EAGAIN the device is being backed off after a failure
+    @retval other error from open, iotctl, write or read functions
+
+==============================================================================*/
+static int ReadChannel( ADS7830 *pADS7830, int channel, uint8_t *data )
+{
+    int result = EINVAL;
+
+    if ( ( pADS7830 != NULL ) &&
+         ( data != NULL ) &&
+         ( channel >= 0 ) &&
+         ( channel < ADS7830_NUM_CHANNELS ) )
+    {
+        if ( HEALTH_Allow( &pADS7830->health, CLOCK_Now() ) == true )
+        {
+            switch ( pADS7830->backend )
+            {
+                case CONFIG_BACKEND_HWMON:
+                case CONFIG_BACKEND_IIO:
+                    result = ReadSysfs( pADS7830, channel, data );
+                    break;
+
+                case CONFIG_BACKEND_REPLAY:
+                    result = REPLAY_Read( &pADS7830->replay,
+                                          channel,
+                                          data );
+                    break;
+
+                default:
+                    result = ReadDevice( pADS7830, channel, data );
+                    break;
+            }
+
+            /* the conversion takes bus time on the simulated clock */
+            CLOCK_Advance( ADS7830_SIM_CONVERSION );
+
+            UpdateHealth( pADS7830, result );
+        }
+        else
+        {
+            /* leave the failing device alone until its backoff expires */
+            result = EAGAIN;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ReadChannels                                                              */
+/*!
+    Read a set of ADC channels
+
+    The ReadChannels function reads a set of ADC channels back to back.
+    With the io_uring backend, the conversions of two or more channels
+    are submitted to the kernel in a single batch.  Otherwise the
+    channels are read one at a time.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channels
+            array of the ids of the channels to read [0..7]
+
+    @param[in]
+        count
+            number of channels to read
+
+    @param[out]
+        data
+            array to store the ADC data of each channel
+
+    @param[out]
+        results
+            array to store the result of reading each channel
+
+==============================================================================*/
+static void ReadChannels( ADS7830 *pADS7830,
+                          const int *channels,
+                          int count,
+                          uint8_t *data,
+                          int *results )
+{
+    int i;
+    int rc;
+
+    if ( ( pADS7830->backend == CONFIG_BACKEND_URING ) &&
+         ( pADS7830->ring.entries > 0 ) &&
+         ( count > 1 ) &&
+         ( HEALTH_Allow( &pADS7830->health, CLOCK_Now() ) == true ) )
+    {
+        rc = ReadRing( pADS7830, channels, data, results, count );
+        CLOCK_Advance( (uint64_t)count * ADS7830_SIM_CONVERSION );
+        if ( rc != EOK )
+        {
+            /* the batch failed as a whole */
+            UpdateHealth( pADS7830, results[0] );
+        }
+        else
+        {
+            for ( i = 0; i < count; i++ )
+            {
+                /* conversions cancelled after a failure were not tried */
+                if ( results[i] != ECANCELED )
+                {
+                    UpdateHealth( pADS7830, results[i] );
+                }
+            }
+        }
+    }
+    else
+    {
+        for ( i = 0; i < count; i++ )
+        {
+            data[i] = 0;
+            results[i] = ReadChannel( pADS7830, channels[i], &data[i] );
+        }
+    }
+}
+
+/*============================================================================*/
+/*  ReadRing                                                                  */
+/*!
+    Read a batch of ADC channels through io_uring
+
+    The ReadRing function submits the conversions for a batch of ADC
+    channels in a single io_uring_enter system call, and waits for them
+    to complete.  The I2C session is kept open for the ring, and is
+    reopened after a batch fails so that a device which reappears is
+    picked up again.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channels
+            array of the ids of the channels to read [0..7]
+
+    @param[out]
+        data
+            array to store the ADC data of each channel
+
+    @param[out]
+        results
+            array to store the result of reading each channel
+
+    @param[in]
+        count
+            number of channels to read [2..8]
+
+    @retval EOK the batch was submitted (see results)
+    @retval other the batch could not be submitted
+
+==============================================================================*/
+static int ReadRing( ADS7830 *pADS7830,
+                     const int *channels,
+                     uint8_t *data,
+                     int *results,
+                     int count )
+{
+    int result = EOK;
+    uint8_t cmd[ADS7830_NUM_CHANNELS];
+    uint64_t start;
+    int i;
+
+    for ( i = 0; i < count; i++ )
+    {
+        cmd[i] = pADS7830->hot.command[channels[i]];
+        data[i] = 0;
+    }
+
+    start = TRACE_Begin();
+
+    if ( pADS7830->fd == -1 )
+    {
+        /* open the session and address the device */
+        result = OpenSession( pADS7830, &pADS7830->fd );
+        if ( ( result == EOK ) &&
+             ( ioctl( pADS7830->fd, I2C_SLAVE, pADS7830->address ) < 0 ) )
+        {
+            result = errno;
+        }
+    }
+
+    if ( result == EOK )
+    {
+        result = URING_Transfer( &pADS7830->ring,
+                                 pADS7830->fd,
+                                 cmd,
+                                 data,
+                                 results,
+                                 count );
+    }
+
+    TRACE_End( TRACE_EVENT_I2C, ( count == 1 ) ? channels[0] : -1, start );
+
+    if ( result != EOK )
+    {
+        for ( i = 0; i < count; i++ )
+        {
+            results[i] = result;
+        }
+    }
+
+    if ( ( ( result != EOK ) || ( results[0] != EOK ) ) &&
+         ( pADS7830->exclusive == false ) &&
+         ( pADS7830->fd != -1 ) )
+    {
+        /* reopen the session on the next batch */
+        close( pADS7830->fd );
+        pADS7830->fd = -1;
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  SetBackend                                                                */
+/*!
+    Set up the data source backend
+
+    The SetBackend function sets up the data source backend selected
+    by the configuration.  The io_uring backend falls back to the i2c
+    backend if io_uring is not available.  The kernel driver backends
+    open the channel attributes in the sysfs device directory once,
+    and keep them open.
+
+    A reload only restarts the recording of the replay backend if the
+    backend, recording or playback speed changed, and only reopens
+    the channel attributes if the backend or sysfs directory changed,
+    so a replay in progress is not rewound by an unrelated change.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+    @param[in]
+        pArena
+            pointer to the new runtime state arena
+
+==============================================================================*/
+static void SetBackend( ADS7830 *pADS7830, Config *pConfig, Arena *pArena )
+{
+    int result = EOK;
+    int backend = pConfig->backend;
+    char *replayFile;
+    char *sysfsDir;
+    bool changed;
+
+    if ( backend == CONFIG_BACKEND_URING )
+    {
+        if ( pADS7830->ring.entries == 0 )
+        {
+            /* two queue entries per conversion of a full scan */
+            result = URING_Init( &pADS7830->ring, 2 * ADS7830_NUM_CHANNELS );
+        }
+
+        if ( result != EOK )
+        {
+            syslog( LOG_ERR,
+                    "io_uring backend unavailable: %s",
+                    strerror( result ) );
+            backend = CONFIG_BACKEND_I2C;
+        }
+        else if ( ( pADS7830->fd != -1 ) &&
+                  ( ioctl( pADS7830->fd,
+                           I2C_SLAVE,
+                           pADS7830->address ) < 0 ) )
+        {
+            syslog( LOG_ERR, "unable to address device" );
+        }
+    }
+
+    if ( backend != CONFIG_BACKEND_URING )
+    {
+        URING_Release( &pADS7830->ring );
+
+        if ( ( pADS7830->exclusive == false ) && ( pADS7830->fd != -1 ) )
+        {
+            /* the i2c backend opens a session for each read */
+            close( pADS7830->fd );
+            pADS7830->fd = -1;
+        }
+    }
+
+    replayFile = ARENA_StrDup( pArena,
+                               CONFIG_GetStr( pConfig, pConfig->replayFile ) );
+    sysfsDir = ARENA_StrDup( pArena,
+                             CONFIG_GetStr( pConfig, pConfig->sysfs ) );
+    changed = ( backend != pADS7830->backend );
+
+    if ( ( changed == true ) ||
+         ( SameString( replayFile, pADS7830->replayFile ) == false ) ||
+         ( pConfig->replaySpeed != pADS7830->replay.speed ) )
+    {
+        /* the recording is reloaded from the start */
+        REPLAY_Release( &pADS7830->replay );
+        if ( backend == CONFIG_BACKEND_REPLAY )
+        {
+            StartReplay( pADS7830, pConfig );
+        }
+    }
+
+    if ( ( changed == true ) ||
+         ( SameString( sysfsDir, pADS7830->sysfsDir ) == false ) )
+    {
+        /* the driver attributes are reopened from the new directory */
+        CloseSysfs( pADS7830 );
+        if ( ( backend == CONFIG_BACKEND_HWMON ) ||
+             ( backend == CONFIG_BACKEND_IIO ) )
+        {
+            OpenSysfs( pADS7830,
+                       pConfig,
+                       ( backend == CONFIG_BACKEND_HWMON )
+                           ? "in%d_input"
+                           : "in_voltage%d_raw" );
+        }
+    }
+
+    /* the names always refer to the current configuration */
+    pADS7830->replayFile = replayFile;
+    pADS7830->sysfsDir = sysfsDir;
+    pADS7830->backend = backend;
+}
+
+/*============================================================================*/
+/*  SameString                                                                */
+/*!
+    Compare two optional strings
+
+    @param[in]
+        s1
+            pointer to the first string (may be NULL)
+
+    @param[in]
+        s2
+            pointer to the second string (may be NULL)
+
+    @retval true the strings are equal, or both are NULL
+    @retval false the strings differ
+
+==============================================================================*/
+static bool SameString( const char *s1, const char *s2 )
+{
+    bool same;
+
+    if ( ( s1 != NULL ) && ( s2 != NULL ) )
+    {
+        same = ( strcmp( s1, s2 ) == 0 );
+    }
+    else
+    {
+        same = ( s1 == s2 );
+    }
+
+    return same;
+}
+
+/*============================================================================*/
+/*  StartReplay                                                               */
+/*!
+    Start the replay backend
+
+    The StartReplay function loads the recording named in the
+    configuration, and starts playing it back.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+==============================================================================*/
+static void StartReplay( ADS7830 *pADS7830, Config *pConfig )
+{
+    char *pFileName = CONFIG_GetStr( pConfig, pConfig->replayFile );
+    int result;
+
+    result = REPLAY_Load( &pADS7830->replay, pFileName );
+    if ( result == EOK )
+    {
+        REPLAY_Start( &pADS7830->replay,
+                      pConfig->replaySpeed,
+                      CLOCK_Now() );
+    }
+    else
+    {
+        syslog( LOG_ERR,
+                "unable to load replay %s: %s",
+                ( pFileName != NULL ) ? pFileName : "(none)",
+                strerror( result ) );
+    }
+
+    pADS7830->replayElapsed = 0;
+}
+
+/*============================================================================*/
+/*  RunReplay                                                                 */
+/*!
+    Run an unpaced replay
+
+    The RunReplay function plays every sample of an unpaced recording
+    through its channel as fast as possible.  Each sample is taken,
+    converted, published, and checked against the alarms and statistics
+    exactly as a sample read from the device, so the throughput of
+    those stages can be measured.  A recording is only played once
+    when it is loaded, not again on a reload which leaves it unchanged.
+    Paced recordings are played by ServiceReplay as their samples fall
+    due instead.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+==============================================================================*/
+static void RunReplay( ADS7830 *pADS7830 )
+{
+    Replay *pReplay = &pADS7830->replay;
+    uint64_t start;
+    int channel;
+
+    if ( ( pADS7830->backend == CONFIG_BACKEND_REPLAY ) &&
+         ( pReplay->count > 0 ) &&
+         ( pReplay->next == 0 ) &&
+         ( pReplay->speed == 0.0f ) )
+    {
+        start = TIMESTAMP_Now();
+
+        while ( REPLAY_Next( pReplay, &channel ) == EOK )
+        {
+            (void)SampleChannel( pADS7830, channel );
+        }
+
+        pADS7830->replayElapsed = TIMESTAMP_Now() - start;
+
+        syslog( LOG_INFO,
+                "replayed %zu samples in %llu us",
+                pReplay->count,
+                (unsigned long long)pADS7830->replayElapsed );
+    }
+}
+
+/*============================================================================*/
+/*  ServiceReplay                                                             */
+/*!
+    Play the recorded samples which are due
+
+    The ServiceReplay function plays every sample of a paced recording
+    whose scaled timestamp has been reached, in recording order, through
+    its channel.  Each recorded sample is published when it falls due,
+    independent of the sample interval of its channel, so short
+    transients in the recording are not lost between periodic samples.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        now
+            current scheduler time in microseconds
+
+    @retval EOK the due samples were played
+    @retval EINVAL invalid arguments
+    @retval other error from SampleChannel
+
+==============================================================================*/
+static int ServiceReplay( ADS7830 *pADS7830, uint64_t now )
+{
+    int result = EINVAL;
+    uint64_t due;
+    int channel;
+    int rc;
+
+    if ( pADS7830 != NULL )
+    {
+        result = EOK;
+
+        due = REPLAY_Due( &pADS7830->replay );
+        while ( ( due != 0 ) && ( due <= now ) )
+        {
+            if ( REPLAY_Next( &pADS7830->replay, &channel ) == EOK )
+            {
+                rc = SampleChannel( pADS7830, channel );
+                if ( rc != EOK )
+                {
+                    result = rc;
+                }
+            }
+
+            due = REPLAY_Due( &pADS7830->replay );
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  OpenSysfs                                                                 */
+/*!
+    Open the channel attributes of a kernel driver
+
+    The OpenSysfs function opens the input attribute of each channel
+    in the sysfs directory of the kernel driver bound to the ADS7830.
+    A channel whose attribute cannot be opened fails to read, and is
+    logged if it has a variable configured.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration naming the sysfs
+            device directory
+
+    @param[in]
+        format
+            format of the channel attribute names
+
+==============================================================================*/
+static void OpenSysfs( ADS7830 *pADS7830,
+                       Config *pConfig,
+                       const char *format )
+{
+    const char *dir = CONFIG_GetStr( pConfig, pConfig->sysfs );
+    char attr[32];
+    int result;
+    int ch;
+
+    if ( dir == NULL )
+    {
+        syslog( LOG_ERR, "no sysfs directory for the kernel driver" );
+    }
+
+    for ( ch = 0; ( dir != NULL ) && ( ch < ADS7830_NUM_CHANNELS ); ch++ )
+    {
+        snprintf( attr, sizeof( attr ), format, ch );
+
+        /* the live channels are not applied yet, so a missing
+           attribute is reported for the configured channels */
+        result = SYSFS_Open( dir, attr, &pADS7830->sysfsFd[ch] );
+        if ( ( result != EOK ) &&
+             ( CONFIG_GetStr( pConfig, pConfig->channels[ch].var ) != NULL ) )
+        {
+            syslog( LOG_ERR,
+                    "unable to open %s/%s: %s",
+                    dir,
+                    attr,
+                    strerror( result ) );
+        }
+    }
+}
+
+/*============================================================================*/
+/*  CloseSysfs                                                                */
+/*!
+    Close the channel attributes of a kernel driver
+
+    The CloseSysfs function closes any open channel input attributes.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+==============================================================================*/
+static void CloseSysfs( ADS7830 *pADS7830 )
+{
+    int ch;
+
+    for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+    {
+        if ( pADS7830->sysfsFd[ch] != -1 )
+        {
+            close( pADS7830->sysfsFd[ch] );
+            pADS7830->sysfsFd[ch] = -1;
+        }
+    }
+}
+
+/*============================================================================*/
+/*  ReadSysfs                                                                 */
+/*!
+    Read an ADC channel from a kernel driver
+
+    The ReadSysfs function reads an ADC channel from the kernel driver
+    bound to the ADS7830, and converts it back to counts so it passes
+    through the same conversion, alarms and statistics as a sample read
+    over i2c-dev.  The hwmon driver reports millivolts, which are
+    converted back with the same vref/255 full scale that is used to
+    publish the counts, so the channel's "vref" must match the
+    driver's.  IIO drivers report the raw counts.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to sample [0..7]
+
+    @param[out]
+        data
+            pointer to a uint8_t location to store the ADC data
+
+    @retval EOK the channel was read successfully
+    @retval other error from SYSFS_Read
+
+==============================================================================*/
+static int ReadSysfs( ADS7830 *pADS7830, int channel, uint8_t *data )
+{
+    int result;
+    long value = 0;
+    float vref;
+    uint64_t start;
+
+    start = TRACE_Begin();
+
+    result = ( pADS7830->sysfsFd[channel] != -1 )
+             ? SYSFS_Read( pADS7830->sysfsFd[channel], &value )
+             : ENOENT;
+    if ( ( result == EOK ) &&
+         ( pADS7830->backend == CONFIG_BACKEND_HWMON ) )
+    {
+        /* convert millivolts to counts on the published full scale */
+        vref = pADS7830->channels[channel].vref;
+        value = ( vref > 0.0f )
+                ? lroundf( ( value * 255.0f ) / ( vref * 1000.0f ) )
+                : 0;
+    }
+
+    *data = ( value < 0 ) ? 0 : ( value > 255 ) ? 255 : value;
+
+    TRACE_End( TRACE_EVENT_I2C, channel, start );
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ReadDevice                                                                */
+/*!
+    Read an ADC channel from the device
+
+    The ReadDevice function performs the I2C transactions to read
+    an ADC channel: it selects the channel with its command byte,
+    and reads back the conversion result.
+
+    The io_uring backend reads single channels this way too, since a
+    direct write and read is cheaper than a round trip through the
+    ring.  It keeps its I2C session open between reads, and reopens it
+    after a failure when the bus is not held exclusively.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to sample [0..7]
+
+    @param[in,out]
+        data
+            pointer to a uint8_t location to store the ADC data
+
+    @retval EOK the channel was read successfully
+    @retval EIO the device did not return the data
+    @retval other error from open, iotctl, write or read functions
+
+==============================================================================*/
+static int ReadDevice( ADS7830 *pADS7830, int channel, uint8_t *data )
+{
+    int result = EINVAL;
+    uint8_t cmd;
+    int fd;
+    bool do_close = false;
+    uint64_t start;
+
+    /* get the precomputed channel command byte */
+    cmd = pADS7830->hot.command[channel];
+
+    if( pADS7830->fd != -1 )
+    {
+        fd = pADS7830->fd;
+
+        /* since the connection was already opened before we
+         * got here, we don't close it when we exit */
+        do_close = false;
+        result = EOK;
+    }
+    else if ( pADS7830->backend == CONFIG_BACKEND_URING )
+    {
+        /* open the session shared with the ring */
+        result = OpenSession( pADS7830, &pADS7830->fd );
+        fd = pADS7830->fd;
+    }
+    else
+    {
+        /* open the i2c device for reading */
+        result = OpenSession( pADS7830, &fd );
+        if( result == EOK )
+        {
+            /* since the connection was not opened when we got here,
+             * we must close it when we exit */
+            do_close = true;
+        }
+    }
+
+    if ( result == EOK )
+    {
+        ADS7830_PROBE2( bus_start, channel, pADS7830->address );
+        start = TRACE_Begin();
+
+        /* set up the device slave address, select the channel,
+         * and read the data */
+        errno = EOK;
+        if ( ( ioctl( fd, I2C_SLAVE, pADS7830->address ) >= 0 ) &&
+             ( write( fd, &cmd, 1 ) == 1 ) &&
+             ( read( fd, data, 1 ) == 1 ) )
+        {
+            result = EOK;
+        }
+        else
+        {
+            result = ( errno != EOK ) ? errno : EIO;
+        }
+
+        TRACE_End( TRACE_EVENT_I2C, channel, start );
+
+        ADS7830_PROBE4( bus_end,
+                        channel,
+                        pADS7830->address,
+                        *data,
+                        result );
+
+        if ( do_close == true )
+        {
+            /* close the channel */
+            close( fd );
+        }
+        else if ( ( result != EOK ) &&
+                  ( pADS7830->backend == CONFIG_BACKEND_URING ) &&
+                  ( pADS7830->exclusive == false ) )
+        {
+            /* reopen the shared session on the next read */
+            close( pADS7830->fd );
+            pADS7830->fd = -1;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  OpenSession                                                               */
+/*!
+    Open an I2C session
+
+    The OpenSession function opens the I2C device and applies the
+    configured adapter timeout and retry count to it.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[out]
+        pfd
+            pointer to a location to store the I2C device file descriptor
+
+    @retval EOK the session was opened
+    @retval EINVAL no I2C device is configured
+    @retval other error from open
+
+==============================================================================*/
+static int OpenSession( ADS7830 *pADS7830, int *pfd )
+{
+    int result = EINVAL;
+
+    *pfd = -1;
+
+    /* only the i2c and io_uring backends need an I2C device */
+    if ( pADS7830->device != NULL )
+    {
+        *pfd = open( pADS7830->device, O_RDWR );
+        result = ( *pfd != -1 ) ? EOK : errno;
+    }
+
+    if ( result == EOK )
+    {
+        SetBusTiming( pADS7830, *pfd );
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  SetBusTiming                                                              */
+/*!
+    Set the I2C adapter timeout and retry count
+
+    The SetBusTiming function applies the configured adapter timeout
+    and retry count to an I2C session with the I2C_TIMEOUT and
+    I2C_RETRIES ioctls, which bounds how long a stuck transaction can
+    block the event loop.  The timeout is set in units of 10 ms, so it
+    is rounded up.  A failure is recorded for the status output, but
+    the session remains usable with the adapter defaults.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        fd
+            I2C device file descriptor
+
+==============================================================================*/
+static void SetBusTiming( ADS7830 *pADS7830, int fd )
+{
+    int result = EOK;
+
+    if ( ( pADS7830->busTimeout > 0 ) &&
+         ( ioctl( fd,
+                  I2C_TIMEOUT,
+                  (unsigned long)( ( pADS7830->busTimeout + 9 ) / 10 ) ) < 0 ) )
+    {
+        result = errno;
+    }
+
+    if ( ( pADS7830->busRetries >= 0 ) &&
+         ( ioctl( fd,
+                  I2C_RETRIES,
+                  (unsigned long)pADS7830->busRetries ) < 0 ) &&
+         ( result == EOK ) )
+    {
+        result = errno;
+    }
+
+    if ( ( result != EOK ) &&
+         ( pADS7830->busResult == EOK ) )
+    {
+        syslog( LOG_WARNING,
+                "unable to set i2c timeout and retries: %s",
+                strerror( result ) );
+    }
+
+    pADS7830->busResult = result;
+}
+
+/*============================================================================*/
+/*  UpdateHealth                                                              */
+/*!
+    Update the device health
+
+    The UpdateHealth function reports the outcome of a bus transaction
+    to the device health tracker, which backs off a failing device
+    exponentially and opens a circuit breaker after repeated failures
+    so that a dead device does not stall the event loop.  Health state
+    changes are logged and published to the health variable.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        result
+            the result of the bus transaction
+
+==============================================================================*/
+static void UpdateHealth( ADS7830 *pADS7830, int result )
+{
+    static const char *states[] = { "ok", "degraded", "failed" };
+    Health *pHealth = &pADS7830->health;
+
+    if ( HEALTH_Report( pHealth, ( result == EOK ), CLOCK_Now() ) )
+    {
+        syslog( ( pHealth->state == HEALTH_OK ) ? LOG_NOTICE : LOG_WARNING,
+                "device 0x%02x health %s: %s",
+                pADS7830->address,
+                states[pHealth->state],
+                strerror( result ) );
+
+        if ( pADS7830->hHealth != VAR_INVALID )
+        {
+            PublishHealth( pADS7830 );
+        }
+    }
+}
+
+/*============================================================================*/
+/*  SetVar                                                                    */
+/*!
+    Set a variable on the variable server
+
+    The SetVar function publishes a value to a variable, unless the
+    server is making a dry run, in which case the value is discarded
+    so a simulated run does not update the live variables.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        hVar
+            handle to the variable to set
+
+    @param[in]
+        pVar
+            pointer to the value to set
+
+    @retval EOK the variable was set or the value was discarded
+    @retval other error from VAR_Set
+
+==============================================================================*/
+static int SetVar( ADS7830 *pADS7830, VAR_HANDLE hVar, VarObject *pVar )
+{
+    int result = EOK;
+
+    if ( pADS7830->dryRun == false )
+    {
+        result = VAR_Set( pADS7830->hVarServer, hVar, pVar );
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  PublishHealth                                                             */
+/*!
+    Publish the device health
+
+    The PublishHealth function publishes the device health state to the
+    health variable as 0 (ok), 1 (degraded) or 2 (failed).
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @retval EOK the health state was published
+    @retval other error from VAR_Set
+
+==============================================================================*/
+static int PublishHealth( ADS7830 *pADS7830 )
+{
+    VarObject var;
+
+    var.type = VARTYPE_UINT16;
+    var.len = sizeof(uint16_t);
+    var.val.ui = pADS7830->health.state;
+
+    return SetVar( pADS7830, pADS7830->hHealth, &var );
+}
+
+/*============================================================================*/
+/*  SetHealth                                                                 */
+/*!
+    Set up the device health tracker
+
+    The SetHealth function applies the device health settings from the
+    configuration, and binds the health variable if one is defined.
+    The device starts in the healthy state when the settings are first
+    applied or are changed.  Otherwise its state and counters are kept
+    across a configuration reload.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+    @param[in]
+        pArena
+            pointer to the arena for the new runtime state
+
+==============================================================================*/
+static void SetHealth( ADS7830 *pADS7830, Config *pConfig, Arena *pArena )
+{
+    Health *pHealth = &pADS7830->health;
+    Health settings;
+
+    HEALTH_Init( &settings,
+                 pConfig->healthThreshold,
+                 (uint64_t)pConfig->healthBackoff * 1000,
+                 (uint64_t)pConfig->healthBackoffMax * 1000,
+                 (uint64_t)pConfig->healthProbe * 1000 );
+
+    if ( ( settings.threshold != pHealth->threshold ) ||
+         ( settings.backoffMin != pHealth->backoffMin ) ||
+         ( settings.backoffMax != pHealth->backoffMax ) ||
+         ( settings.probeInterval != pHealth->probeInterval ) )
+    {
+        /* a reload with unchanged settings keeps the device state */
+        *pHealth = settings;
+    }
+
+    pADS7830->healthName =
+        ARENA_StrDup( pArena, CONFIG_GetStr( pConfig, pConfig->healthVar ) );
+
+    pADS7830->hHealth = ( pADS7830->healthName != NULL )
+                        ? VAR_FindByName( pADS7830->hVarServer,
+                                          pADS7830->healthName )
+                        : VAR_INVALID;
+
+    if ( pADS7830->hHealth != VAR_INVALID )
+    {
+        PublishHealth( pADS7830 );
+    }
+}
+
+/*============================================================================*/
+/*  LoadConfig                                                                */
+/*!
+    Load the ADS7830 configuration
+
+    The LoadConfig function loads the compiled ADS7830 configuration.
+    If a configuration cache file was specified and it is up to date,
+    it is mapped directly into memory.  Otherwise the JSON configuration
+    file is parsed and compiled, the JSON tree is released, and the
+    cache file (if specified) is refreshed.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in,out]
+        pImage
+            pointer to the configuration image to populate
+
+    @retval EOK the configuration was loaded
+    @retval ENOENT the configuration file could not be parsed
+    @retval EINVAL invalid arguments
+    @retval other error writing the cache file in compile-only mode
+
+==============================================================================*/
+static int LoadConfig( ADS7830 *pADS7830, ConfigImage *pImage )
+{
+    int result = EINVAL;
+    JNode *config;
+    int rc;
+
+    if ( ( pADS7830 != NULL ) &&
+         ( pImage != NULL ) )
+    {
+        result = ENOENT;
+
+        if ( ( pADS7830->pCacheFile != NULL ) &&
+             ( pADS7830->compileOnly == false ) )
+        {
+            /* try the compiled configuration cache first */
+            result = CONFIG_Load( pADS7830->pCacheFile,
+                                  pADS7830->pFileName,
+                                  pImage );
+        }
+
+        if ( result != EOK )
+        {
+            /* fall back to the JSON configuration */
+            config = JSON_Process( pADS7830->pFileName );
+            if ( config != NULL )
+            {
+                /* output the confguration file */
+                if( pADS7830->verbose == true )
+                {
+                    JSON_Print(config, stdout, false );
+                    printf("\n");
+                }
+
+                result = CONFIG_Compile( config,
+                                         pADS7830->pFileName,
+                                         pImage );
+
+                JSON_Free( config );
+            }
+            else
+            {
+                result = ENOENT;
+            }
+
+            if ( ( result == EOK ) &&
+                 ( pADS7830->pCacheFile != NULL ) )
+            {
+                /* refresh the compiled configuration cache */
+                rc = CONFIG_Save( pImage, pADS7830->pCacheFile );
+                if ( rc != EOK )
+                {
+                    syslog( LOG_WARNING,
+                            "unable to write %s: %s",
+                            pADS7830->pCacheFile,
+                            strerror( rc ) );
+
+                    if ( pADS7830->compileOnly == true )
+                    {
+                        /* writing the cache was the whole job */
+                        result = rc;
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ApplyConfig                                                               */
+/*!
+    Apply an ADS7830 configuration
+
+    The ApplyConfig function applies the channel definitions from the
+    specified compiled configuration to the running ADS7830 controller.
+    The new channel set is compared against the live channel set, and
+    only the schedules and variable bindings which have changed are
+    recreated or retuned.  Channels which are unchanged keep sampling
+    without interruption.
+
+    All runtime state derived from the configuration is copied into
+    a new arena sized for the configuration, which replaces (and
+    releases) the previous arena.  The compiled configuration is
+    released once it has been applied.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        pImage
+            pointer to the compiled configuration to apply
+
+    @retval EOK the configuration was applied
+    @retval ENOMEM the runtime state arena could not be allocated
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+static int ApplyConfig( ADS7830 *pADS7830, ConfigImage *pImage )
+{
+    int result = EINVAL;
+    AIN channels[ADS7830_NUM_CHANNELS];
+    Arena arena;
+    Arena old;
+    Config *pConfig;
+    int ch;
+    int rc;
+
+    if ( ( pADS7830 != NULL ) &&
+         ( pImage != NULL ) &&
+         ( pImage->pConfig != NULL ) )
+    {
+        pConfig = pImage->pConfig;
+
+        /* size the runtime state arena for the new configuration */
+        result = ARENA_Init( &arena, GetArenaSize( pConfig ) );
+    }
+
+    if ( result == EOK )
+    {
+        /* build the new channel set */
+        memset( channels, 0, sizeof( channels ) );
+        for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+        {
+            channels[ch].name =
+                ARENA_StrDup( &arena,
+                              CONFIG_GetStr( pConfig,
+                                             pConfig->channels[ch].var ) );
+            channels[ch].interval = pConfig->channels[ch].interval;
+            channels[ch].adaptMin = pConfig->channels[ch].adaptMin;
+            channels[ch].adaptMax = pConfig->channels[ch].adaptMax;
+            channels[ch].adaptThreshold =
+                pConfig->channels[ch].adaptThreshold;
+            channels[ch].input = pConfig->channels[ch].input;
+            channels[ch].power = pConfig->channels[ch].power;
+            channels[ch].vref = pConfig->channels[ch].vref;
+            channels[ch].scale = pConfig->channels[ch].scale;
+            channels[ch].offset = pConfig->channels[ch].offset;
+            channels[ch].decimals = pConfig->channels[ch].decimals;
+            channels[ch].units =
+                ARENA_StrDup( &arena,
+                              CONFIG_GetStr( pConfig,
+                                             pConfig->channels[ch].units ) );
+            channels[ch].lut =
+                CopyTable( &arena,
+                           CONFIG_GetTable( pConfig,
+                                            pConfig->channels[ch].table ) );
+
+            /* get the threshold alarm definition */
+            channels[ch].alarmName = GetAlarmName( &arena, pConfig, ch );
+            channels[ch].alarm.hasHigh =
+                ( pConfig->channels[ch].alarmLimits & CONFIG_ALARM_HIGH ) != 0;
+            channels[ch].alarm.hasLow =
+                ( pConfig->channels[ch].alarmLimits & CONFIG_ALARM_LOW ) != 0;
+            channels[ch].alarm.high = pConfig->channels[ch].alarmHigh;
+            channels[ch].alarm.low = pConfig->channels[ch].alarmLow;
+            channels[ch].alarm.hysteresis =
+                pConfig->channels[ch].alarmHysteresis;
+            channels[ch].alarm.duration =
+                (uint64_t)pConfig->channels[ch].alarmDuration * 1000;
+
+            /* set up the rolling window statistics */
+            if ( pConfig->channels[ch].statsWindow > 0 )
+            {
+                STATS_Init( &channels[ch].stats,
+                            &arena,
+                            pConfig->channels[ch].statsSamples,
+                            (uint64_t)pConfig->channels[ch].statsWindow
+                                * 1000 );
+                channels[ch].statsInterval =
+                    (uint64_t)pConfig->channels[ch].statsInterval * 1000;
+            }
+        }
+
+        /* get the name and address of the i2c device */
+        pADS7830->device =
+            ARENA_StrDup( &arena,
+                          CONFIG_GetStr( pConfig, pConfig->device ) );
+
+        pADS7830->address = pConfig->address;
+
+        /* apply the adapter timeout and retry count to an open session */
+        pADS7830->busTimeout = pConfig->timeout;
+        pADS7830->busRetries = pConfig->retries;
+        if ( pADS7830->fd != -1 )
+        {
+            SetBusTiming( pADS7830, pADS7830->fd );
+        }
+
+        /* set up the data source backend */
+        SetBackend( pADS7830, pConfig, &arena );
+
+        /* set up the bus transaction budget, keeping its level */
+        BUCKET_Configure( &pADS7830->budget,
+                          pConfig->budgetRate,
+                          pConfig->budgetBurst,
+                          CLOCK_Now() );
+        pADS7830->budgetPolicy = pConfig->budgetPolicy;
+
+        /* set up the packed scan */
+        SetScan( pADS7830, pConfig, &arena );
+
+        /* set up the device health tracker */
+        SetHealth( pADS7830, pConfig, &arena );
+
+        /* apply the differences to the live channel set */
+        for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+        {
+            rc = ApplyChannel( pADS7830, ch, &channels[ch] );
+            if ( rc != EOK )
+            {
+                result = rc;
+            }
+        }
+
+        /* swap in the new runtime state */
+        old = pADS7830->arena;
+        pADS7830->arena = arena;
+        ARENA_Release( &old );
+
+        /* play an unpaced recording through the new channel set */
+        RunReplay( pADS7830 );
+    }
+
+    if ( pImage != NULL )
+    {
+        /* the runtime state no longer refers to the configuration */
+        CONFIG_Release( pImage );
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  GetArenaSize                                                              */
+/*!
+    Calculate the runtime state arena size for a configuration
+
+    The GetArenaSize function calculates the size of the arena required
+    to hold all the runtime state for the specified configuration.
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+    @retval size of the runtime state arena in bytes
+
+==============================================================================*/
+static size_t GetArenaSize( Config *pConfig )
+{
+    size_t size = 0;
+    int ch;
+
+    if ( pConfig != NULL )
+    {
+        /* channel and device names */
+        size += ARENA_Reserve( pConfig->strtabSize, 1 );
+
+        for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+        {
+            /* conversion tables */
+            if ( pConfig->channels[ch].table != 0 )
+            {
+                size += ARENA_Reserve( LUT_SIZE * sizeof( float ),
+                                       ADS7830_CACHE_LINE );
+            }
+
+            /* rolling window statistics */
+            if ( pConfig->channels[ch].statsWindow > 0 )
+            {
+                size += STATS_ArenaSize( pConfig->channels[ch].statsSamples );
+            }
+
+            /* default alarm variable names */
+            if ( ( pConfig->channels[ch].alarmLimits != 0 ) &&
+                 ( pConfig->channels[ch].alarmVar == 0 ) )
+            {
+                size += ARENA_Reserve( MAX_NAME_LEN, 1 );
+            }
+        }
+    }
+
+    return size;
+}
+
+/*============================================================================*/
+/*  CopyTable                                                                 */
+/*!
+    Copy a conversion table into the runtime state arena
+
+    The CopyTable function copies a conversion table from the compiled
+    configuration into the runtime state arena, cache line aligned.
+
+    @param[in]
+        pArena
+            pointer to the runtime state arena
+
+    @param[in]
+        pTable
+            pointer to the LUT_SIZE entry conversion table (may be NULL)
+
+    @retval pointer to the copied conversion table
+    @retval NULL if there is no table or it could not be copied
+
+==============================================================================*/
+static const float *CopyTable( Arena *pArena, const float *pTable )
+{
+    float *pCopy = NULL;
+
+    if ( pTable != NULL )
+    {
+        pCopy = ARENA_Alloc( pArena,
+                             LUT_SIZE * sizeof( float ),
+                             ADS7830_CACHE_LINE );
+        if ( pCopy != NULL )
+        {
+            memcpy( pCopy, pTable, LUT_SIZE * sizeof( float ) );
+        }
+    }
+
+    return pCopy;
+}
+
+/*============================================================================*/
+/*  ApplyChannel                                                              */
+/*!
+    Apply an ADS7830 channel definition
+
+    The ApplyChannel function compares a newly parsed channel definition
+    against the live channel state and updates the variable bindings
+    and sample schedule only if they have changed.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to update [0..7]
+
+    @param[in]
+        pNew
+            pointer to the new channel definition
+
+    @retval EOK the channel was updated
+    @retval EINVAL invalid arguments
+    @retval other error from the notification functions
+
+==============================================================================*/
+static int ApplyChannel( ADS7830 *pADS7830, int channel, AIN *pNew )
+{
+    int result = EINVAL;
+    AIN *pAIN;
+    bool rebind;
+    int rc;
+
+    if ( ( pADS7830 != NULL ) &&
+         ( pNew != NULL ) &&
+         ( channel >= 0 ) &&
+         ( channel < ADS7830_NUM_CHANNELS ) )
+    {
+        result = EOK;
+        pAIN = &pADS7830->channels[channel];
+
+        if ( ( pAIN->name != NULL ) && ( pNew->name != NULL ) )
+        {
+            rebind = ( strcmp( pAIN->name, pNew->name ) != 0 );
+        }
+        else
+        {
+            rebind = ( pAIN->name != pNew->name );
+        }
+
+        /* the name always refers to the current configuration */
+        pAIN->name = pNew->name;
+
+        if ( rebind == true )
+        {
+            if ( pAIN->calcNotify == true )
+            {
+                /* the old variable is no longer sampled on demand */
+                (void)VAR_NotifyCancel( pADS7830->hVarServer,
+                                        pAIN->hVar,
+                                        NOTIFY_CALC );
+            }
+
+            pAIN->hVar = ( pNew->name != NULL )
+                         ? VAR_FindByName( pADS7830->hVarServer, pNew->name )
+                         : VAR_INVALID;
+            pAIN->calcNotify = false;
+
+            /* the variable type selects the published format */
+            if ( ( pAIN->hVar == VAR_INVALID ) ||
+                 ( VAR_GetType( pADS7830->hVarServer,
+                                pAIN->hVar,
+                                &pADS7830->hot.type[channel] ) != EOK ) )
+            {
+                pADS7830->hot.type[channel] = VARTYPE_UINT16;
+            }
+
+            BindControls( pADS7830, channel );
+        }
+
+        /* the input and conversion can always be updated in place */
+        SetInput( pADS7830, channel, pNew );
+        SetConversion( pADS7830, channel, pNew );
+        SetAdaptive( pADS7830, channel, pNew );
+
+        if ( pAIN->cfgInterval != pNew->interval )
+        {
+            pAIN->cfgInterval = pNew->interval;
+            result = SetInterval( pADS7830, channel, pNew->interval );
+        }
+        else if ( rebind == true )
+        {
+            result = SetInterval( pADS7830, channel, pAIN->interval );
+        }
+
+        /* the alarm is rebound if its variable changed */
+        rc = SetAlarm( pADS7830, channel, pNew );
+        if ( rc != EOK )
+        {
+            result = rc;
+        }
+
+        /* the statistics window is carried into the new arena */
+        SetStats( pADS7830, channel, pNew );
+
+        if ( rebind == true )
+        {
+            /* the control variables override the configuration */
+            ApplyControls( pADS7830, channel );
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  SetConversion                                                             */
+/*!
+    Set the engineering unit conversion of a channel
+
+    The SetConversion function applies a channel's engineering unit
+    conversion settings, and precomputes the per-count gain and
+    fixed-point multiplier (or selects the conversion table) used
+    when each sample is published.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to update [0..7]
+
+    @param[in]
+        pNew
+            pointer to the new channel definition
+
+==============================================================================*/
+static void SetConversion( ADS7830 *pADS7830, int channel, AIN *pNew )
+{
+    AIN *pAIN = &pADS7830->channels[channel];
+    AINHot *pHot = &pADS7830->hot;
+
+    pAIN->vref = pNew->vref;
+    pAIN->scale = pNew->scale;
+    pAIN->offset = pNew->offset;
+    pAIN->units = pNew->units;
+    pAIN->decimals = pNew->decimals;
+    pAIN->lut = pNew->lut;
+
+    pHot->gain[channel] = ( pAIN->vref * pAIN->scale ) / 255.0f;
+    pHot->offset[channel] = pAIN->offset;
+    pHot->lut[channel] = pAIN->lut;
+    pHot->fixed[channel] = ( pAIN->decimals > 0 )
+                           ? powf( 10.0f, pAIN->decimals )
+                           : 0.0f;
+}
+
+/*============================================================================*/
+/*  SetAdaptive                                                               */
+/*!
+    Set the adaptive sampling interval of a channel
+
+    The SetAdaptive function applies a channel's adaptive sampling
+    settings.  Channels without an adaptive interval are sampled at
+    a fixed interval.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to update [0..7]
+
+    @param[in]
+        pNew
+            pointer to the new channel definition
+
+==============================================================================*/
+static void SetAdaptive( ADS7830 *pADS7830, int channel, AIN *pNew )
+{
+    AIN *pAIN = &pADS7830->channels[channel];
+    AINHot *pHot = &pADS7830->hot;
+
+    pAIN->adaptMin = pNew->adaptMin;
+    pAIN->adaptMax = pNew->adaptMax;
+    pAIN->adaptThreshold = pNew->adaptThreshold;
+
+    pHot->minPeriod[channel] = (uint64_t)pAIN->adaptMin * 1000;
+    pHot->maxPeriod[channel] = (uint64_t)pAIN->adaptMax * 1000;
+    pHot->threshold[channel] = ( pAIN->adaptThreshold > UINT8_MAX )
+                               ? UINT8_MAX
+                               : pAIN->adaptThreshold;
+}
+
+/*============================================================================*/
+/*  AdaptInterval                                                             */
+/*!
+    Adapt the sampling period of a channel to its signal activity
+
+    The AdaptInterval function drops the sampling period of an adaptive
+    channel to its minimum when the change since the previous sample
+    exceeds the channel threshold, so transients are captured with
+    fine resolution.  Otherwise the period is doubled, up to its
+    maximum, so quiet signals use little bus and varserver bandwidth.
+
+    @param[in]
+        pHot
+            pointer to the hot channel state
+
+    @param[in]
+        channel
+            the id of the sampled channel [0..7]
+
+    @param[in]
+        previous
+            the previous sample of the channel
+
+==============================================================================*/
+static void AdaptInterval( AINHot *pHot, int channel, uint16_t previous )
+{
+    int delta = (int)pHot->value[channel] - (int)previous;
+
+    if ( ( delta > pHot->threshold[channel] ) ||
+         ( -delta > pHot->threshold[channel] ) )
+    {
+        pHot->period[channel] = pHot->minPeriod[channel];
+    }
+    else if ( pHot->period[channel] < pHot->maxPeriod[channel] )
+    {
+        pHot->period[channel] *= 2;
+        if ( pHot->period[channel] > pHot->maxPeriod[channel] )
+        {
+            pHot->period[channel] = pHot->maxPeriod[channel];
+        }
+    }
+}
+
+/*============================================================================*/
+/*  SetAlarm                                                                  */
+/*!
+    Set the threshold alarm of a channel
+
+    The SetAlarm function applies a channel's threshold alarm definition
+    and binds its alarm variable.  If the alarm variable is unchanged the
+    current alarm state is kept, otherwise the alarm starts in the normal
+    state, which is published to the alarm variable.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to update [0..7]
+
+    @param[in]
+        pNew
+            pointer to the new channel definition
+
+    @retval EOK the alarm was applied
+    @retval other error from PublishAlarm
+
+==============================================================================*/
+static int SetAlarm( ADS7830 *pADS7830, int channel, AIN *pNew )
+{
+    int result = EOK;
+    AIN *pAIN = &pADS7830->channels[channel];
+    VAR_HANDLE hAlarm = VAR_INVALID;
+    Alarm old = pAIN->alarm;
+
+    if ( pNew->alarmName != NULL )
+    {
+        hAlarm = VAR_FindByName( pADS7830->hVarServer, pNew->alarmName );
+        if ( hAlarm == VAR_INVALID )
+        {
+            syslog( LOG_ERR, "alarm variable %s not found", pNew->alarmName );
+        }
+    }
+
+    pAIN->alarmName = pNew->alarmName;
+    pAIN->alarm = pNew->alarm;
+
+    if ( ( hAlarm != VAR_INVALID ) &&
+         ( hAlarm == pAIN->hAlarm ) )
+    {
+        /* keep the alarm state across the reload */
+        pAIN->alarm.state = old.state;
+        pAIN->alarm.pending = old.pending;
+        pAIN->alarm.since = old.since;
+    }
+    else
+    {
+        pAIN->alarm.state = ALARM_NORMAL;
+        pAIN->alarm.pending = ALARM_NORMAL;
+        pAIN->hAlarm = hAlarm;
+
+        if ( hAlarm != VAR_INVALID )
+        {
+            result = PublishAlarm( pADS7830, channel );
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  GetAlarmName                                                              */
+/*!
+    Get the alarm variable name of a channel
+
+    The GetAlarmName function copies the alarm variable name of a
+    channel into the runtime state arena.  If the alarm does not specify
+    a variable, the "<var>/ALARM" variable of the channel is used.
+
+    @param[in]
+        pArena
+            pointer to the runtime state arena
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+    @param[in]
+        channel
+            the id of the channel [0..7]
+
+    @retval pointer to the alarm variable name
+    @retval NULL if the channel has no alarm
+
+==============================================================================*/
+static char *GetAlarmName( Arena *pArena, Config *pConfig, int channel )
+{
+    ConfigChannel *pChannel = &pConfig->channels[channel];
+    char *name = NULL;
+    char *var;
+
+    if ( pChannel->alarmLimits != 0 )
+    {
+        if ( pChannel->alarmVar != 0 )
+        {
+            name = ARENA_StrDup( pArena,
+                                 CONFIG_GetStr( pConfig,
+                                                pChannel->alarmVar ) );
+        }
+        else
+        {
+            var = CONFIG_GetStr( pConfig, pChannel->var );
+            if ( var != NULL )
+            {
+                name = ARENA_Alloc( pArena, MAX_NAME_LEN, 1 );
+                if ( name != NULL )
+                {
+                    snprintf( name, MAX_NAME_LEN, "%s/ALARM", var );
+                }
+            }
+        }
+    }
+
+    return name;
+}
+
+/*============================================================================*/
+/*  CheckAlarm                                                                */
+/*!
+    Check the threshold alarm of a channel
+
+    The CheckAlarm function evaluates the threshold alarm of a channel
+    against a new sample, and publishes the alarm state to the alarm
+    variable only if it changed.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the sampled channel [0..7]
+
+    @param[in]
+        data
+            the ADC sample in counts
+
+    @retval EOK the alarm was checked
+    @retval other error from PublishAlarm
+
+==============================================================================*/
+static int CheckAlarm( ADS7830 *pADS7830, int channel, uint8_t data )
+{
+    int result = EOK;
+
+    if ( ALARM_Evaluate( &pADS7830->channels[channel].alarm,
+                         ToEngineering( &pADS7830->hot, channel, data ),
+                         pADS7830->hot.timestamp[channel] ) == true )
+    {
+        result = PublishAlarm( pADS7830, channel );
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  PublishAlarm                                                              */
+/*!
+    Publish the alarm state of a channel
+
+    The PublishAlarm function sets the alarm variable of a channel
+    to its current alarm state (see AlarmState).
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel [0..7]
+
+    @retval EOK the alarm state was published
+    @retval other error from VAR_Set
+
+==============================================================================*/
+static int PublishAlarm( ADS7830 *pADS7830, int channel )
+{
+    AIN *pAIN = &pADS7830->channels[channel];
+    VarObject var;
+
+    var.type = VARTYPE_UINT16;
+    var.len = sizeof(uint16_t);
+    var.val.ui = pAIN->alarm.state;
+
+    return SetVar( pADS7830, pAIN->hAlarm, &var );
+}
+
+/*============================================================================*/
+/*  SetStats                                                                  */
+/*!
+    Set the rolling window statistics of a channel
+
+    The SetStats function applies a channel's rolling window statistics
+    definition, and binds the <var>/MIN, <var>/MAX, <var>/MEAN and
+    <var>/STDDEV companion variables which exist.  If the window
+    capacity, window length and publication interval are unchanged,
+    the samples in the live window are carried into the new arena and
+    the next publication stays due when it was, so a reload does not
+    interrupt the statistics.  Otherwise the window starts empty.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to update [0..7]
+
+    @param[in]
+        pNew
+            pointer to the new channel definition
+
+==============================================================================*/
+static void SetStats( ADS7830 *pADS7830, int channel, AIN *pNew )
+{
+    AIN *pAIN = &pADS7830->channels[channel];
+    static const char *suffix[ADS7830_NUM_STATS] =
+        { "MIN", "MAX", "MEAN", "STDDEV" };
+    char name[MAX_NAME_LEN];
+    int i;
+
+    if ( ( pNew->stats.capacity != 0 ) &&
+         ( pNew->stats.capacity == pAIN->stats.capacity ) &&
+         ( pNew->stats.window == pAIN->stats.window ) &&
+         ( pNew->statsInterval == pAIN->statsInterval ) &&
+         ( STATS_Copy( &pNew->stats, &pAIN->stats ) == EOK ) )
+    {
+        /* keep the window and the publication schedule */
+        pAIN->stats = pNew->stats;
+    }
+    else
+    {
+        pAIN->stats = pNew->stats;
+        pAIN->statsInterval = pNew->statsInterval;
+        pAIN->statsNext = CLOCK_Now() + pAIN->statsInterval;
+    }
+
+    for ( i = 0; i < ADS7830_NUM_STATS; i++ )
+    {
+        pAIN->hStats[i] = VAR_INVALID;
+
+        if ( ( pAIN->stats.capacity != 0 ) &&
+             ( pAIN->name != NULL ) )
+        {
+            snprintf( name, sizeof( name ), "%s/%s", pAIN->name, suffix[i] );
+            pAIN->hStats[i] = VAR_FindByName( pADS7830->hVarServer, name );
+        }
+    }
+}
+
+/*============================================================================*/
+/*  UpdateStats                                                               */
+/*!
+    Update the rolling window statistics of a channel
+
+    The UpdateStats function adds a new sample to the rolling window
+    statistics of a channel, and publishes the statistics if they
+    are due.  The statistics are published as part of a sample, so
+    they are not published while the channel is not being sampled.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the sampled channel [0..7]
+
+    @param[in]
+        data
+            the ADC sample in counts
+
+==============================================================================*/
+static void UpdateStats( ADS7830 *pADS7830, int channel, uint8_t data )
+{
+    AIN *pAIN = &pADS7830->channels[channel];
+    uint64_t now = pADS7830->hot.timestamp[channel];
+
+    STATS_Add( &pAIN->stats,
+               ToEngineering( &pADS7830->hot, channel, data ),
+               now );
+
+    if ( now >= pAIN->statsNext )
+    {
+        PublishStats( pADS7830, channel, now );
+
+        pAIN->statsNext += pAIN->statsInterval;
+        if ( pAIN->statsNext <= now )
+        {
+            pAIN->statsNext = now + pAIN->statsInterval;
+        }
+    }
+}
+
+/*============================================================================*/
+/*  PublishStats                                                              */
+/*!
+    Publish the rolling window statistics of a channel
+
+    The PublishStats function sets the statistics companion variables
+    of a channel to the minimum, maximum, mean and standard deviation
+    of the samples in its statistics window.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel [0..7]
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+    @retval EOK the statistics were published
+    @retval ENODATA there are no samples in the window
+    @retval other error from VAR_Set
+
+==============================================================================*/
+static int PublishStats( ADS7830 *pADS7830, int channel, uint64_t now )
+{
+    AIN *pAIN = &pADS7830->channels[channel];
+    StatsResult stats;
+    VarObject var;
+    float values[ADS7830_NUM_STATS];
+    int result;
+    int rc;
+    int i;
+
+    result = STATS_Get( &pAIN->stats, now, &stats );
+    if ( result == EOK )
+    {
+        values[0] = stats.min;
+        values[1] = stats.max;
+        values[2] = stats.mean;
+        values[3] = stats.stddev;
+
+        var.type = VARTYPE_FLOAT;
+        var.len = sizeof(float);
+
+        for ( i = 0; i < ADS7830_NUM_STATS; i++ )
+        {
+            if ( pAIN->hStats[i] != VAR_INVALID )
+            {
+                var.val.f = values[i];
+                rc = SetVar( pADS7830, pAIN->hStats[i], &var );
+                if ( rc != EOK )
+                {
+                    result = rc;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  SetInput                                                                  */
+/*!
+    Set the input and power-down modes of a channel
+
+    The SetInput function applies a channel's input and power-down
+    modes, and precomputes the ADS7830 command byte used to sample it.
+
+    In single-ended mode the channel input is measured against COM.
+    In differential mode the channel input is the positive input, and
+    the other channel of its pair is the negative input.  Both use the
+    same channel select bits:
+
+        single-ended: C2 C1 C0 = CH0 CH2 CH4 CH6 CH1 CH3 CH5 CH7
+        differential: C2 C1 C0 = 0+1- 2+3- 4+5- 6+7- 0-1+ 2-3+ 4-5+ 6-7+
+
+    so the select bits for a channel are ( odd << 2 ) | ( channel / 2 )
+    in either mode.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel to update [0..7]
+
+    @param[in]
+        pNew
+            pointer to the new channel definition
+
+==============================================================================*/
+static void SetInput( ADS7830 *pADS7830, int channel, AIN *pNew )
+{
+    AIN *pAIN = &pADS7830->channels[channel];
+    uint8_t cmd;
+
+    pAIN->input = pNew->input;
+    pAIN->power = pNew->power;
+
+    cmd = ( ( ( channel & 1 ) << 2 ) | ( channel >> 1 ) )
+          << ADS7830_CMD_CHANNEL_SHIFT;
+
+    if ( pAIN->input != CONFIG_INPUT_DIFFERENTIAL )
+    {
+        cmd |= ADS7830_CMD_SINGLE_ENDED;
     }
 
-    return result;
+    cmd |= ( pAIN->power & CONFIG_POWER_ON ) << ADS7830_CMD_PD_SHIFT;
+
+    pADS7830->hot.command[channel] = cmd;
 }
 
 /*============================================================================*/
-/*  FindChannel                                                               */
+/*  SetInterval                                                               */
 /*!
-    Find an ADC channel
+    Set the sampling interval of a channel
 
-    The FindChannnel function finds the ADC channel associated with the
-    specified variable handle.
+    The SetInterval function applies a new sampling interval to a
+    channel, scheduling, rescheduling or unscheduling its next sample
+    deadline as required.  An interval of zero selects on-demand sampling
+    via a CALC notification, which is cancelled again when the channel
+    returns to periodic sampling.  Disabled channels keep their interval
+    but are not scheduled.
 
     @param[in]
         pADS7830
             pointer to the ADS7830 controller state object
 
     @param[in]
-        hVar
-            handle to a variable associated with an ADC channel
+        channel
+            the id of the channel to update [0..7]
 
-    @retval channel id in the range [0..ADS7830_NUM_CHANNELS]
-    @retval -1 if the channel is not found
+    @param[in]
+        interval
+            the sampling interval in milliseconds
+
+    @retval EOK the interval was applied
+    @retval EINVAL invalid arguments
+    @retval other error from the notification functions
 
 ==============================================================================*/
-static int FindChannel( ADS7830 *pADS7830, VAR_HANDLE hVar )
+static int SetInterval( ADS7830 *pADS7830, int channel, int interval )
 {
-    int channel = -1;
-    int i;
+    int result = EINVAL;
+    AIN *pAIN;
+    int timeoutms;
 
-    if( ( pADS7830 != NULL ) &&
-        ( hVar != VAR_INVALID ) )
+    if ( ( pADS7830 != NULL ) &&
+         ( channel >= 0 ) &&
+         ( channel < ADS7830_NUM_CHANNELS ) &&
+         ( interval >= 0 ) )
     {
-        for( i = 0; i < ADS7830_NUM_CHANNELS; i ++ )
+        result = EOK;
+        pAIN = &pADS7830->channels[channel];
+        pAIN->interval = interval;
+
+        timeoutms = ( pAIN->disabled == true ) ? 0 : interval;
+
+        /* schedule (or unschedule) the next sample */
+        pADS7830->hot.period[channel] = (uint64_t)timeoutms * 1000;
+        pADS7830->hot.deadline[channel] = ( timeoutms > 0 )
+                        ? CLOCK_Now() + pADS7830->hot.period[channel]
+                        : 0;
+
+        if ( ( interval == 0 ) &&
+             ( pAIN->hVar != VAR_INVALID ) &&
+             ( pAIN->calcNotify == false ) )
         {
-            if( pADS7830->channels[i].hVar == hVar )
-            {
-                channel = i;
-                break;
-            }
+            /* sample on demand */
+            result = VAR_Notify( pADS7830->hVarServer,
+                                 pAIN->hVar,
+                                 NOTIFY_CALC );
+            pAIN->calcNotify = ( result == EOK );
+        }
+        else if ( ( interval != 0 ) &&
+                  ( pAIN->calcNotify == true ) )
+        {
+            /* sample periodically only */
+            result = VAR_NotifyCancel( pADS7830->hVarServer,
+                                       pAIN->hVar,
+                                       NOTIFY_CALC );
+            pAIN->calcNotify = ( result != EOK );
         }
     }
 
-    return channel;
+    return result;
 }
 
 /*============================================================================*/
-/*  SampleChannel                                                             */
+/*  BindControls                                                              */
 /*!
-    Sample the specified ADC channel
+    Bind the optional channel control variables
 
-    The SampleChannel function samples the specified ADC channel and writes
-    the result to the system variable associated with that channel
+    The BindControls function looks up the optional control variables
+    associated with a channel variable, and requests a modified
+    notification for each one which exists:
+
+        <var>/INTERVAL  : sampling interval in milliseconds
+        <var>/ENABLE    : 0 to disable sampling, non-zero to enable it
 
     @param[in]
         pADS7830
@@ -727,38 +4255,45 @@ static int FindChannel( ADS7830 *pADS7830, VAR_HANDLE hVar )
 
     @param[in]
         channel
-            the id of the channel to sample [0..7]
+            the id of the channel to bind [0..7]
 
-    @retval EOK the channel was sampled successfully
+    @retval EOK the control variables were bound
     @retval EINVAL invalid arguments
-    @retval other error from open, iotctl, or VAR_Set functions
 
 ==============================================================================*/
-static int SampleChannel( ADS7830 *pADS7830, int channel )
+static int BindControls( ADS7830 *pADS7830, int channel )
 {
     int result = EINVAL;
-    uint8_t data;
-    VarObject var;
-    VAR_HANDLE hVar;
+    AIN *pAIN;
+    char name[MAX_NAME_LEN];
 
     if ( ( pADS7830 != NULL ) &&
          ( channel >= 0 ) &&
          ( channel < ADS7830_NUM_CHANNELS ) )
     {
-        /* get the system variable handle for the channel */
-        hVar = pADS7830->channels[channel].hVar;
-        if ( hVar != VAR_INVALID )
+        result = EOK;
+        pAIN = &pADS7830->channels[channel];
+        pAIN->hInterval = VAR_INVALID;
+        pAIN->hEnable = VAR_INVALID;
+
+        if ( pAIN->name != NULL )
         {
-            result = ReadChannel( pADS7830, channel, &data );
-            if ( result == EOK )
+            snprintf( name, sizeof( name ), "%s/INTERVAL", pAIN->name );
+            pAIN->hInterval = VAR_FindByName( pADS7830->hVarServer, name );
+            if ( pAIN->hInterval != VAR_INVALID )
             {
-                /* populate the variable data */
-                var.type = VARTYPE_UINT16;
-                var.len = sizeof(uint16_t);
-                var.val.ui = data;
+                VAR_Notify( pADS7830->hVarServer,
+                            pAIN->hInterval,
+                            NOTIFY_MODIFIED );
+            }
 
-                /* set the variable value */
-                result = VAR_Set( pADS7830->hVarServer, hVar, &var );
+            snprintf( name, sizeof( name ), "%s/ENABLE", pAIN->name );
+            pAIN->hEnable = VAR_FindByName( pADS7830->hVarServer, name );
+            if ( pAIN->hEnable != VAR_INVALID )
+            {
+                VAR_Notify( pADS7830->hVarServer,
+                            pAIN->hEnable,
+                            NOTIFY_MODIFIED );
             }
         }
     }
@@ -767,252 +4302,204 @@ static int SampleChannel( ADS7830 *pADS7830, int channel )
 }
 
 /*============================================================================*/
-/*  ReadChannel                                                               */
+/*  HandleControl                                                             */
 /*!
-    Read the specified ADC channel
+    Handle a change to a channel control variable
 
-    The ReadChannel function reads the specified ADC channel and puts
-    the value in the location pointed to by 'data'
+    The HandleControl function applies a modified channel control
+    variable (INTERVAL or ENABLE) to the sampling schedule.  Intervals
+    shorter than ADS7830_MIN_CONTROL_INTERVAL (other than 0 for
+    on-demand sampling) are rejected.
 
     @param[in]
         pADS7830
             pointer to the ADS7830 controller state object
 
     @param[in]
-        channel
-            the id of the channel to sample [0..7]
-
-    @param[in,out]
-        data
-            pointer to a uint8_t location to store the ADC data
+        hVar
+            handle of the modified variable
 
-    @retval EOK the channel was read successfully
+    @retval EOK the control was applied
+    @retval ENOENT the variable is not a channel control variable
+    @retval ERANGE the interval is too short
     @retval EINVAL invalid arguments
-    @retval other error from open, iotctl, or VAR_Set functions
 
 ==============================================================================*/
-static int ReadChannel( ADS7830 *pADS7830, int channel, uint8_t *data )
+static int HandleControl( ADS7830 *pADS7830, VAR_HANDLE hVar )
 {
     int result = EINVAL;
-    uint8_t ch;
-    uint8_t cmd;
-    uint8_t single_ended = 0x80; // bit 7 set for single-ended
-    uint8_t dac_on_ref_off = 0x04; // bits 2-3 -- ad on, reference off
-    int fd;
-    bool do_close = false;
-    static uint8_t chval[ADS7830_NUM_CHANNELS] = {0,4,1,5,2,6,3,7};
+    AIN *pAIN;
+    VarObject var;
+    int ch;
+    int value;
 
     if ( ( pADS7830 != NULL ) &&
-         ( pADS7830->device != NULL ) &&
-         ( data != NULL ) &&
-         ( channel >= 0 ) &&
-         ( channel < ADS7830_NUM_CHANNELS ) )
+         ( hVar != VAR_INVALID ) )
     {
-		/* build channel selector bits for single-ended ADC */
-		ch = chval[channel] << 4;
-        cmd = single_ended | dac_on_ref_off | ch;
-
-        if( pADS7830->fd == -1 )
-        {
-            fd = pADS7830->fd;
-
-            /* since the connection was already opened before we
-             * got here, we don't close it when we exit */
-            do_close = false;
-        }
-        else
-        {
-            /* open the i2c device for reading */
-            fd = open( pADS7830->device, O_RDWR );
-            if( fd != -1 )
-            {
-                /* since the connection was not opened when we got here,
-                 * we must close it when we exit */
-                do_close = true;
-            }
-        }
+        result = ENOENT;
 
-        if ( fd != -1 )
+        for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
         {
-            /* set up the device slave address */
-            if (ioctl( fd, I2C_SLAVE, pADS7830->address ) >= 0 )
-            {
-                /* set up the channel to read */
-                write( fd, &cmd, 1 );
-
-                /* read the data */
-                read( fd, data, 1 );
-
-                result = EOK;
-            }
-            else
+            pAIN = &pADS7830->channels[ch];
+            if ( ( hVar == pAIN->hInterval ) || ( hVar == pAIN->hEnable ) )
             {
-                result = errno;
-            }
+                result = VAR_Get( pADS7830->hVarServer, hVar, &var );
+                if ( result == EOK )
+                {
+                    value = GetIntValue( &var );
+                    if ( hVar == pAIN->hEnable )
+                    {
+                        pAIN->disabled = ( value == 0 );
+                        result = SetInterval( pADS7830, ch, pAIN->interval );
+                    }
+                    else if ( ( value > 0 ) &&
+                              ( value < ADS7830_MIN_CONTROL_INTERVAL ) )
+                    {
+                        syslog( LOG_WARNING,
+                                "%s: interval %d ms is below %d ms",
+                                pAIN->name,
+                                value,
+                                ADS7830_MIN_CONTROL_INTERVAL );
+                        result = ERANGE;
+                    }
+                    else if ( value != pAIN->interval )
+                    {
+                        result = SetInterval( pADS7830, ch, value );
+                    }
+                }
 
-            if ( do_close == true )
-            {
-                /* close the channel */
-                close( fd );
+                break;
             }
         }
-        else
-        {
-            result = errno;
-        }
     }
 
     return result;
 }
 
 /*============================================================================*/
-/*  ParseChannel                                                              */
+/*  ApplyControls                                                             */
 /*!
-    Parse an ADS7830 channel definition
+    Apply the current values of the channel control variables
+
+    The ApplyControls function reads the current values of a channel's
+    control variables and applies them to the sampling schedule, so
+    persisted ENABLE and INTERVAL values take effect as soon as the
+    channel is bound, rather than on their next change.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
+
+    @param[in]
+        channel
+            the id of the channel [0..7]
+
+==============================================================================*/
+static void ApplyControls( ADS7830 *pADS7830, int channel )
+{
+    AIN *pAIN = &pADS7830->channels[channel];
 
-    The ParseChannel function is a callback function for the JSON_Iterate
-    function which parses an ADS7830 channel definition object.
-    The channel definition object is expected to look as follows:
+    if ( pAIN->hEnable != VAR_INVALID )
+    {
+        (void)HandleControl( pADS7830, pAIN->hEnable );
+    }
 
+    if ( pAIN->hInterval != VAR_INVALID )
     {
-      "channel" : "3",
-      "var" : "/HW/ADS7830/A3",
-      "interval" : "1000"
+        (void)HandleControl( pADS7830, pAIN->hInterval );
     }
+}
 
-    If "interval" is not specified or set to 0, then the channnel will
-    be sampled on demand via a CALC notification.
+/*============================================================================*/
+/*  GetIntValue                                                               */
+/*!
+    Get the integer value of a variable object
 
-    @param[in]
-       pNode
-            pointer to the channel node
+    The GetIntValue function converts the value of a numeric variable
+    object to an integer.
 
     @param[in]
-        arg
-            opaque pointer argument used for the ads7830 state object
+        pVar
+            pointer to the variable object
 
-    @retval EOK - the channel object was parsed successfully
-    @retval EINVAL - the channel object could not be parsed
+    @retval the integer value of the variable
+    @retval 0 if the variable is not numeric
 
 ==============================================================================*/
-static int ParseChannel( JNode *pNode, void *arg )
+static int GetIntValue( VarObject *pVar )
 {
-    int result = EINVAL;
-    ADS7830 *pADS7830 = (ADS7830 *)arg;
-    int channel;
-    char *var;
-    char *attr;
-    VAR_HANDLE hVar;
-    int interval;
+    int value = 0;
 
-    if ( ( pNode != NULL ) &&
-         ( pADS7830 != NULL ) )
+    if ( pVar != NULL )
     {
-        /* get the mandatory channel index */
-        attr = JSON_GetStr( pNode, "channel" );
-        channel = attr != NULL ? atoi( attr ) : -1;
-
-        if( ( channel >= 0 ) &&
-            ( channel < ADS7830_NUM_CHANNELS ) )
+        switch( pVar->type )
         {
-            /* get the sampling interval (if any) */
-            attr = JSON_GetStr( pNode, "interval" );
-            if( attr != NULL )
-            {
-                interval = atoi( attr );
-                pADS7830->channels[channel].interval = interval;
-                result = CreateTimer( pADS7830, channel, interval );
-            }
-            else
-            {
-                pADS7830->channels[channel].interval = 0;
-                interval = 0;
-            }
+            case VARTYPE_UINT16:
+                value = pVar->val.ui;
+                break;
 
-            attr = JSON_GetStr( pNode, "var" );
-            if ( attr != NULL )
-            {
-                pADS7830->channels[channel].name = attr;
-                hVar = VAR_FindByName( pADS7830->hVarServer, attr );
-                pADS7830->channels[channel].hVar = hVar;
-            }
-            else
-            {
-                pADS7830->channels[channel].hVar = VAR_INVALID;
-            }
+            case VARTYPE_INT16:
+                value = pVar->val.i;
+                break;
 
-            if ( interval == 0 )
-            {
-                result = VAR_Notify( pADS7830->hVarServer, hVar, NOTIFY_CALC );
-            }
+            case VARTYPE_UINT32:
+                value = pVar->val.ul;
+                break;
+
+            case VARTYPE_INT32:
+                value = pVar->val.l;
+                break;
+
+            case VARTYPE_FLOAT:
+                value = (int)pVar->val.f;
+                break;
+
+            default:
+                break;
         }
     }
 
-    return EOK;
+    return value;
 }
 
 /*============================================================================*/
-/*  CreateTimer                                                               */
+/*  ReloadConfig                                                              */
 /*!
-    Create a repeating timer
-
-    The CreateTimer creates a repeating timer which will fire
-    at the specified interval
-
+    Reload the ADS7830 configuration
 
-@param[in]
-    pADS7830
-        pointer to the ADS7830 controller state object
-
-@param[in]
-    channel
-        channel id of the timer to create
+    The ReloadConfig function re-reads the ADS7830 configuration
+    and applies any changes to the running controller.  If the
+    configuration cannot be loaded, the current configuration
+    is retained.
 
-@param[in]
-    interval
-        timer interval in milliseconds
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 controller state object
 
-@retval EOK the timer was created
-@retval EINVAL invalid arguments
+    @retval EOK the configuration was reloaded
+    @retval ENOENT the configuration file could not be parsed
+    @retval EINVAL invalid arguments
 
 ==============================================================================*/
-static int CreateTimer( ADS7830 *pADS7830, int channel, int timeoutms )
+static int ReloadConfig( ADS7830 *pADS7830 )
 {
-    struct sigevent te;
-    struct itimerspec its;
-    int sigNo = TIMER_NOTIFICATION;
-    long secs;
-    long msecs;
-    timer_t *timerID;
     int result = EINVAL;
+    ConfigImage config;
 
-    secs = timeoutms / 1000;
-    msecs = timeoutms % 1000;
-
-    if( ( pADS7830 != NULL ) &&
-        ( channel >= 0 ) &&
-        ( channel < ADS7830_NUM_CHANNELS ) )
-    {
-        /* get the timer ID */
-        timerID = &(pADS7830->channels[channel].timer);
-
-        /* Set and enable alarm */
-        te.sigev_notify = SIGEV_SIGNAL;
-        te.sigev_signo = sigNo;
-        te.sigev_value.sival_int = channel;
-        timer_create(CLOCK_REALTIME, &te, timerID);
-
-        its.it_interval.tv_sec = secs;
-        its.it_interval.tv_nsec = msecs * 1000000L;
-        its.it_value.tv_sec = secs;
-        its.it_value.tv_nsec = msecs * 1000000L;
-        timer_settime(*timerID, 0, &its, NULL);
-
-        result = EOK;
-    }
-    else
+    if ( pADS7830 != NULL )
     {
-        result = ENOENT;
+        result = LoadConfig( pADS7830, &config );
+        if ( result == EOK )
+        {
+            result = ApplyConfig( pADS7830, &config );
+            syslog( LOG_INFO, "reloaded %s", pADS7830->pFileName );
+        }
+        else
+        {
+            syslog( LOG_ERR,
+                    "unable to reload %s",
+                    pADS7830->pFileName );
+        }
     }
 
     return result;
@@ -1044,6 +4531,7 @@ static int SetupPrintNotifications( ADS7830 *pADS7830 )
     if ( pADS7830 != NULL )
     {
         hVar = VAR_FindByName( pADS7830->hVarServer, "/HW/ADS7830/INFO" );
+        pADS7830->hInfo = hVar;
         if( hVar != VAR_INVALID )
         {
             result = VAR_Notify( pADS7830->hVarServer,
@@ -1054,11 +4542,82 @@ static int SetupPrintNotifications( ADS7830 *pADS7830 )
         {
             result = ENOENT;
         }
+
+        /* the timeline trace variable is optional */
+        hVar = VAR_FindByName( pADS7830->hVarServer, "/HW/ADS7830/TRACE" );
+        pADS7830->hTrace = hVar;
+        if ( hVar != VAR_INVALID )
+        {
+            VAR_Notify( pADS7830->hVarServer, hVar, NOTIFY_PRINT );
+        }
+
+        /* the flight recorder variable is optional */
+        hVar = VAR_FindByName( pADS7830->hVarServer, "/HW/ADS7830/FLIGHT" );
+        pADS7830->hFlight = hVar;
+        if ( hVar != VAR_INVALID )
+        {
+            VAR_Notify( pADS7830->hVarServer, hVar, NOTIFY_PRINT );
+        }
     }
 
     return result;
 }
 
+/*============================================================================*/
+/*  ApplyRealtime                                                             */
+/*!
+    Apply the real-time profile to the acquisition thread
+
+    The ApplyRealtime function applies the real-time execution profile
+    requested on the command line to the calling acquisition thread,
+    and logs any setting which could not be applied.  The daemon keeps
+    running with its default scheduling if a setting fails, and the
+    result of each setting is reported in the status output.
+
+    @param[in]
+        pADS7830
+            pointer to the ADS7830 state
+
+==============================================================================*/
+static void ApplyRealtime( ADS7830 *pADS7830 )
+{
+    RTProfile *pRT;
+
+    if ( pADS7830 != NULL )
+    {
+        pRT = &pADS7830->rt;
+
+        if ( RT_Apply( pRT ) != EOK )
+        {
+            if ( ( pRT->schedResult != RT_NOT_REQUESTED ) &&
+                 ( pRT->schedResult != EOK ) )
+            {
+                syslog( LOG_WARNING,
+                        "unable to set SCHED_FIFO priority %d: %s",
+                        pRT->priority,
+                        strerror( pRT->schedResult ) );
+            }
+
+            if ( ( pRT->lockResult != RT_NOT_REQUESTED ) &&
+                 ( pRT->lockResult != EOK ) )
+            {
+                syslog( LOG_WARNING,
+                        "unable to lock memory: %s",
+                        strerror( pRT->lockResult ) );
+            }
+
+            if ( ( pRT->affinityResult != RT_NOT_REQUESTED ) &&
+                 ( pRT->affinityResult != EOK ) )
+            {
+                syslog( LOG_WARNING,
+                        "unable to set CPU affinity 0x%llx: %s",
+                        (unsigned long long)pRT->affinity,
+                        strerror( pRT->affinityResult ) );
+            }
+        }
+    }
+}
+
 /*============================================================================*/
 /*  PrintStatus                                                               */
 /*!
@@ -1080,16 +4639,144 @@ static int PrintStatus (ADS7830 *pADS7830, int fd )
     AIN *channel;
     uint8_t data;
     int ch;
+    float eng;
+    char *units;
+    char *alarm;
+    char label[8];
+    char timeout[16];
+    char retries[16];
+    static char *alarms[] = { " [ok]", " [LOW]", " [HIGH]" };
+    static char *health[] = { "ok", "degraded", "failed" };
+    static char *backends[] = { "i2c", "io_uring", "hwmon", "iio", "replay" };
 
     if ( ( pADS7830 != NULL ) &&
          ( fd != -1 ) )
     {
         dprintf(fd, "ADS7830 Status:\n");
         dprintf(fd, "Configuration File: %s\n", pADS7830->pFileName );
-        dprintf(fd, "Device: %s\n", pADS7830->device );
+        dprintf(fd,
+                "Device: %s\n",
+                ( pADS7830->device != NULL ) ? pADS7830->device : "none" );
         dprintf(fd, "Address: 0x%02x\n", pADS7830->address );
+
+        /* show the effective adapter timeout and retry count */
+        if ( pADS7830->busTimeout > 0 )
+        {
+            snprintf( timeout,
+                      sizeof( timeout ),
+                      "%d ms",
+                      ( ( pADS7830->busTimeout + 9 ) / 10 ) * 10 );
+        }
+        else
+        {
+            strcpy( timeout, "default" );
+        }
+
+        if ( pADS7830->busRetries >= 0 )
+        {
+            snprintf( retries, sizeof( retries ), "%d", pADS7830->busRetries );
+        }
+        else
+        {
+            strcpy( retries, "default" );
+        }
+
+        dprintf(fd,
+                "Timeout: %s, Retries: %s%s%s\n",
+                timeout,
+                retries,
+                ( pADS7830->busResult != EOK ) ? ", not applied: " : "",
+                ( pADS7830->busResult != EOK )
+                    ? strerror( pADS7830->busResult )
+                    : "" );
+        dprintf(fd,
+                "Backend: %s\n",
+                ( pADS7830->backend <= CONFIG_BACKEND_REPLAY )
+                    ? backends[pADS7830->backend]
+                    : "unknown" );
+        if ( ( pADS7830->backend == CONFIG_BACKEND_REPLAY ) &&
+             ( pADS7830->replay.speed == 0.0f ) )
+        {
+            dprintf(fd,
+                    "Replay: %zu of %zu samples, unpaced in %llu us\n",
+                    pADS7830->replay.next,
+                    pADS7830->replay.count,
+                    (unsigned long long)pADS7830->replayElapsed );
+        }
+        else if ( pADS7830->backend == CONFIG_BACKEND_REPLAY )
+        {
+            dprintf(fd,
+                    "Replay: %zu of %zu samples, speed %g\n",
+                    pADS7830->replay.next,
+                    pADS7830->replay.count,
+                    pADS7830->replay.speed );
+        }
+
         dprintf(fd, "Exclusive: %s\n", pADS7830->exclusive ? "true" : "false" );
         dprintf(fd, "Verbose: %s\n", pADS7830->verbose ? "true" : "false" );
+        dprintf(fd,
+                "Priority: %llu preemptions, %llu starvation guards\n",
+                (unsigned long long)pADS7830->preemptions,
+                (unsigned long long)pADS7830->starvationGuards );
+
+        dprintf(fd,
+                "Schedule: %llu samples, late max %llu us mean %llu us, "
+                "%llu overruns\n",
+                (unsigned long long)pADS7830->scheduled,
+                (unsigned long long)pADS7830->lateMax,
+                (unsigned long long)( ( pADS7830->scheduled != 0 )
+                    ? pADS7830->lateTotal / pADS7830->scheduled
+                    : 0 ),
+                (unsigned long long)pADS7830->overruns );
+
+        if ( CLOCK_IsSimulated() == true )
+        {
+            dprintf(fd,
+                    "Simulated: %llu s in %llu us\n",
+                    (unsigned long long)pADS7830->simulate,
+                    (unsigned long long)pADS7830->simElapsed );
+        }
+
+        if ( pADS7830->budget.rate != 0 )
+        {
+            dprintf(fd,
+                    "Budget: %u/s %s, %llu dropped, %llu stretched\n",
+                    pADS7830->budget.rate,
+                    ( pADS7830->budgetPolicy == CONFIG_BUDGET_STRETCH )
+                        ? "stretch"
+                        : "drop",
+                    (unsigned long long)pADS7830->budgetDropped,
+                    (unsigned long long)pADS7830->budgetStretched );
+        }
+        else
+        {
+            dprintf(fd, "Budget: unlimited\n" );
+        }
+
+        dprintf(fd,
+                "Realtime: SCHED_FIFO %d %s, mlockall %s, affinity 0x%llx %s\n",
+                pADS7830->rt.priority,
+                RT_Result( pADS7830->rt.schedResult ),
+                RT_Result( pADS7830->rt.lockResult ),
+                (unsigned long long)pADS7830->rt.affinity,
+                RT_Result( pADS7830->rt.affinityResult ) );
+
+        dprintf(fd,
+                "Health: %s, %llu errors, %llu trips, %llu probes, "
+                "%llu recoveries\n",
+                health[pADS7830->health.state],
+                (unsigned long long)pADS7830->health.errors,
+                (unsigned long long)pADS7830->health.trips,
+                (unsigned long long)pADS7830->health.probes,
+                (unsigned long long)pADS7830->health.recoveries );
+
+        if ( pADS7830->hScan != VAR_INVALID )
+        {
+            dprintf(fd,
+                    "Scan: %s %d ms\n",
+                    pADS7830->scanName,
+                    (int)( pADS7830->hot.scanPeriod / 1000 ) );
+        }
         dprintf(fd, "Channels:\n" );
 
         for( ch=0; ch < ADS7830_NUM_CHANNELS; ch++ )
@@ -1098,26 +4785,62 @@ static int PrintStatus (ADS7830 *pADS7830, int fd )
 
             /* get the channel data */
             data = 0;
+            BUCKET_Charge( &pADS7830->budget, CLOCK_Now() );
             (void)ReadChannel( pADS7830, ch, &data );
 
-            if( channel->interval )
+            /* convert the channel data to engineering units */
+            eng = ToEngineering( &pADS7830->hot, ch, data );
+            units = ( channel->units != NULL ) ? channel->units : "V";
+
+            /* show the alarm state of channels with an alarm */
+            alarm = ( ( channel->hAlarm != VAR_INVALID ) &&
+                      ( channel->alarm.state <= ALARM_HIGH ) )
+                    ? alarms[channel->alarm.state]
+                    : "";
+
+            /* differential channels are labelled with their pair */
+            if ( channel->input == CONFIG_INPUT_DIFFERENTIAL )
+            {
+                snprintf( label, sizeof( label ), "A%d-A%d", ch, ch ^ 1 );
+            }
+            else
+            {
+                snprintf( label, sizeof( label ), "A%d", ch );
+            }
+
+            if( channel->disabled )
+            {
+                dprintf( fd,
+                         "\t%s: %s   off   %03d %0.2f%s%s\n",
+                         label,
+                         channel->name,
+                         data,
+                         eng,
+                         units,
+                         alarm );
+            }
+            else if( channel->interval )
             {
                 dprintf( fd,
-                         "\tA%d: %s %4d ms %03d %0.2fV\n",
-                         ch,
+                         "\t%s: %s %4d ms %03d %0.2f%s%s\n",
+                         label,
                          channel->name,
-                         channel->interval,
+                         (int)( pADS7830->hot.period[ch] / 1000 ),
                          data,
-                         ((float)data/255.0) * 3.3);
+                         eng,
+                         units,
+                         alarm );
             }
             else
             {
                 dprintf( fd,
-                         "\tA%d: %s ------- %03d %0.2fV\n",
-                         ch,
+                         "\t%s: %s ------- %03d %0.2f%s%s\n",
+                         label,
                          channel->name,
                          data,
-                         ((float)data/255.0) * 3.3);
+                         eng,
+                         units,
+                         alarm );
             }
         }
     }
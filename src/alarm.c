@@ -0,0 +1,147 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup alarm alarm
+ * @brief Threshold alarms for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file alarm.c
+
+    Threshold Alarms
+
+    Threshold alarms are evaluated on each sample of a channel, so
+    consumers can be notified of alarm transitions instead of polling
+    the channel variables.  An alarm is raised when the value crosses
+    a high or low limit, and cleared when it moves back inside the
+    limit by more than the hysteresis.  A transition is only reported
+    once it has persisted for the minimum duration.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stddef.h>
+#include "alarm.h"
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  ALARM_Evaluate                                                            */
+/*!
+    Evaluate a threshold alarm
+
+    The ALARM_Evaluate function evaluates a threshold alarm against
+    a new sample, and updates the alarm state if a transition has
+    persisted for the minimum duration.
+
+    @param[in,out]
+        pAlarm
+            pointer to the alarm to evaluate
+
+    @param[in]
+        value
+            the new sample in engineering units
+
+    @param[in]
+        now
+            timestamp of the sample in microseconds
+
+    @retval true the alarm state changed
+    @retval false the alarm state did not change
+
+==============================================================================*/
+bool ALARM_Evaluate( Alarm *pAlarm, float value, uint64_t now )
+{
+    bool changed = false;
+    AlarmState target;
+
+    if ( pAlarm != NULL )
+    {
+        target = pAlarm->state;
+
+        switch( pAlarm->state )
+        {
+            case ALARM_HIGH:
+                if ( value < pAlarm->high - pAlarm->hysteresis )
+                {
+                    target = ALARM_NORMAL;
+                }
+                break;
+
+            case ALARM_LOW:
+                if ( value > pAlarm->low + pAlarm->hysteresis )
+                {
+                    target = ALARM_NORMAL;
+                }
+                break;
+
+            default:
+                if ( ( pAlarm->hasHigh == true ) && ( value > pAlarm->high ) )
+                {
+                    target = ALARM_HIGH;
+                }
+                else if ( ( pAlarm->hasLow == true ) &&
+                          ( value < pAlarm->low ) )
+                {
+                    target = ALARM_LOW;
+                }
+                break;
+        }
+
+        if ( target == pAlarm->state )
+        {
+            /* no transition pending */
+            pAlarm->pending = target;
+        }
+        else
+        {
+            if ( target != pAlarm->pending )
+            {
+                /* start timing a new transition */
+                pAlarm->pending = target;
+                pAlarm->since = now;
+            }
+
+            if ( now - pAlarm->since >= pAlarm->duration )
+            {
+                pAlarm->state = target;
+                changed = true;
+            }
+        }
+    }
+
+    return changed;
+}
+
+/*! @}
+ * end of alarm group */
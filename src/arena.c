@@ -0,0 +1,265 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup arena arena
+ * @brief Runtime state arena for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file arena.c
+
+    Runtime State Arena
+
+    The arena module provides a single fixed size block of memory
+    which is sized and allocated when a configuration is applied.
+    All runtime state which depends on the configuration is carved
+    out of the arena, so the steady-state acquisition loop never
+    touches the heap, and the whole state is released in one step
+    when the configuration is replaced.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include "arena.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  ARENA_Reserve                                                             */
+/*!
+    Calculate the arena space required for an allocation
+
+    The ARENA_Reserve function calculates the worst case number of
+    arena bytes consumed by an allocation of the specified size and
+    alignment.  It is used to size an arena before it is created.
+
+    @param[in]
+        size
+            size of the allocation in bytes
+
+    @param[in]
+        align
+            alignment of the allocation (a power of 2)
+
+    @retval worst case number of arena bytes required
+
+==============================================================================*/
+size_t ARENA_Reserve( size_t size, size_t align )
+{
+    return ( align > 1 ) ? size + align - 1 : size;
+}
+
+/*============================================================================*/
+/*  ARENA_Init                                                                */
+/*!
+    Create an arena
+
+    The ARENA_Init function allocates the memory for an arena.
+    The memory is zero filled and pre-faulted.
+
+    @param[in,out]
+        pArena
+            pointer to the arena to initialize
+
+    @param[in]
+        size
+            size of the arena in bytes
+
+    @retval EOK the arena was created
+    @retval ENOMEM memory allocation failed
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+int ARENA_Init( Arena *pArena, size_t size )
+{
+    int result = EINVAL;
+
+    if ( pArena != NULL )
+    {
+        pArena->pBase = NULL;
+        pArena->size = 0;
+        pArena->used = 0;
+
+        if ( size > 0 )
+        {
+            pArena->pBase = malloc( size );
+            if ( pArena->pBase != NULL )
+            {
+                /* touch every page now rather than in the sample path */
+                memset( pArena->pBase, 0, size );
+                pArena->size = size;
+                result = EOK;
+            }
+            else
+            {
+                result = ENOMEM;
+            }
+        }
+        else
+        {
+            result = EOK;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ARENA_Alloc                                                               */
+/*!
+    Allocate memory from an arena
+
+    The ARENA_Alloc function carves a zero filled block of memory
+    out of an arena.  Arena memory cannot be freed individually.
+
+    @param[in]
+        pArena
+            pointer to the arena
+
+    @param[in]
+        size
+            size of the allocation in bytes
+
+    @param[in]
+        align
+            alignment of the allocation (a power of 2)
+
+    @retval pointer to the allocated memory
+    @retval NULL if the arena is exhausted
+
+==============================================================================*/
+void *ARENA_Alloc( Arena *pArena, size_t size, size_t align )
+{
+    void *p = NULL;
+    uintptr_t addr;
+    size_t offset;
+
+    if ( ( pArena != NULL ) &&
+         ( pArena->pBase != NULL ) &&
+         ( size > 0 ) )
+    {
+        if ( align == 0 )
+        {
+            align = 1;
+        }
+
+        addr = (uintptr_t)( pArena->pBase + pArena->used );
+        addr = ( addr + align - 1 ) & ~( (uintptr_t)align - 1 );
+        offset = addr - (uintptr_t)pArena->pBase;
+
+        if ( ( offset <= pArena->size ) &&
+             ( size <= pArena->size - offset ) )
+        {
+            p = pArena->pBase + offset;
+            pArena->used = offset + size;
+        }
+    }
+
+    return p;
+}
+
+/*============================================================================*/
+/*  ARENA_StrDup                                                              */
+/*!
+    Copy a string into an arena
+
+    The ARENA_StrDup function copies a NUL terminated string into
+    an arena.
+
+    @param[in]
+        pArena
+            pointer to the arena
+
+    @param[in]
+        str
+            pointer to the string to copy
+
+    @retval pointer to the copy of the string
+    @retval NULL if the string is NULL or the arena is exhausted
+
+==============================================================================*/
+char *ARENA_StrDup( Arena *pArena, const char *str )
+{
+    char *p = NULL;
+    size_t len;
+
+    if ( str != NULL )
+    {
+        len = strlen( str ) + 1;
+        p = ARENA_Alloc( pArena, len, 1 );
+        if ( p != NULL )
+        {
+            memcpy( p, str, len );
+        }
+    }
+
+    return p;
+}
+
+/*============================================================================*/
+/*  ARENA_Release                                                             */
+/*!
+    Release an arena
+
+    The ARENA_Release function releases the memory of an arena.
+    All pointers into the arena become invalid.
+
+    @param[in]
+        pArena
+            pointer to the arena to release
+
+==============================================================================*/
+void ARENA_Release( Arena *pArena )
+{
+    if ( pArena != NULL )
+    {
+        free( pArena->pBase );
+        pArena->pBase = NULL;
+        pArena->size = 0;
+        pArena->used = 0;
+    }
+}
+
+/*! @}
+ * end of arena group */
@@ -0,0 +1,361 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup bucket bucket
+ * @brief Token bucket rate limiter for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file bucket.c
+
+    Token Bucket
+
+    The token bucket limits the rate of I2C bus transactions so the
+    ADS7830 server stays within a budget on a bus shared with other
+    devices.  The bucket refills at a fixed rate up to a burst capacity,
+    and each bus transaction consumes one token.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stddef.h>
+#include "bucket.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+/*! one token in millionths of a token */
+#define BUCKET_TOKEN 1000000LL
+
+/*==============================================================================
+        Private function declarations
+==============================================================================*/
+
+static void Refill( TokenBucket *pBucket, uint64_t now );
+static int64_t Required( TokenBucket *pBucket, int64_t tokens );
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  BUCKET_Init                                                               */
+/*!
+    Initialize a token bucket
+
+    The BUCKET_Init function initializes a full token bucket.
+
+    @param[in]
+        pBucket
+            pointer to the token bucket to initialize
+
+    @param[in]
+        rate
+            refill rate in tokens per second (0 for unlimited)
+
+    @param[in]
+        burst
+            bucket capacity in tokens (at least 1)
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+==============================================================================*/
+void BUCKET_Init( TokenBucket *pBucket,
+                  uint32_t rate,
+                  uint32_t burst,
+                  uint64_t now )
+{
+    if ( pBucket != NULL )
+    {
+        pBucket->rate = rate;
+        pBucket->capacity = ( ( burst > 0 ) ? burst : 1 ) * BUCKET_TOKEN;
+        pBucket->level = pBucket->capacity;
+        pBucket->last = now;
+    }
+}
+
+/*============================================================================*/
+/*  BUCKET_Configure                                                          */
+/*!
+    Apply the settings of a token bucket
+
+    The BUCKET_Configure function initializes a full token bucket if
+    its rate or capacity differ from the specified settings.  If they
+    are unchanged, the level and last refill time are kept, so
+    reapplying the same settings never grants an extra burst.
+
+    @param[in]
+        pBucket
+            pointer to the token bucket to configure
+
+    @param[in]
+        rate
+            refill rate in tokens per second (0 for unlimited)
+
+    @param[in]
+        burst
+            bucket capacity in tokens (at least 1)
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+==============================================================================*/
+void BUCKET_Configure( TokenBucket *pBucket,
+                       uint32_t rate,
+                       uint32_t burst,
+                       uint64_t now )
+{
+    if ( ( pBucket != NULL ) &&
+         ( ( pBucket->rate != rate ) ||
+           ( pBucket->capacity
+             != ( ( burst > 0 ) ? burst : 1 ) * BUCKET_TOKEN ) ) )
+    {
+        BUCKET_Init( pBucket, rate, burst, now );
+    }
+}
+
+/*============================================================================*/
+/*  BUCKET_Take                                                               */
+/*!
+    Take tokens from a token bucket
+
+    The BUCKET_Take function takes the specified number of tokens from
+    the token bucket if they are all available.  A request larger than
+    the bucket capacity is granted once the bucket is full, and is
+    charged in full by leaving the bucket in debt, so the long term
+    rate is still enforced.
+
+    @param[in]
+        pBucket
+            pointer to the token bucket
+
+    @param[in]
+        count
+            number of tokens to take
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+    @retval true the tokens were taken (or the bucket is unlimited)
+    @retval false not enough tokens are available
+
+==============================================================================*/
+bool BUCKET_Take( TokenBucket *pBucket, uint32_t count, uint64_t now )
+{
+    bool result = true;
+    int64_t tokens;
+
+    if ( ( pBucket != NULL ) &&
+         ( pBucket->rate != 0 ) )
+    {
+        Refill( pBucket, now );
+
+        tokens = (int64_t)count * BUCKET_TOKEN;
+        if ( pBucket->level >= Required( pBucket, tokens ) )
+        {
+            pBucket->level -= tokens;
+        }
+        else
+        {
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  BUCKET_Charge                                                             */
+/*!
+    Charge a token to a token bucket
+
+    The BUCKET_Charge function takes a token from the token bucket
+    whether or not one is available.  It is used for transactions
+    which must not be refused.  The bucket may go into debt by up to
+    its capacity, which delays subsequent BUCKET_Take calls.
+
+    @param[in]
+        pBucket
+            pointer to the token bucket
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+==============================================================================*/
+void BUCKET_Charge( TokenBucket *pBucket, uint64_t now )
+{
+    if ( ( pBucket != NULL ) &&
+         ( pBucket->rate != 0 ) )
+    {
+        Refill( pBucket, now );
+
+        /* never reduce a deeper debt left by an oversized request */
+        if ( pBucket->level > -pBucket->capacity )
+        {
+            pBucket->level -= BUCKET_TOKEN;
+            if ( pBucket->level < -pBucket->capacity )
+            {
+                pBucket->level = -pBucket->capacity;
+            }
+        }
+    }
+}
+
+/*============================================================================*/
+/*  BUCKET_Delay                                                              */
+/*!
+    Get the time until tokens are available
+
+    The BUCKET_Delay function calculates how long it will be until
+    the specified number of tokens can be taken from the token bucket.
+
+    @param[in]
+        pBucket
+            pointer to the token bucket
+
+    @param[in]
+        count
+            number of tokens required
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+    @retval time until the tokens are available in microseconds
+
+==============================================================================*/
+uint64_t BUCKET_Delay( TokenBucket *pBucket, uint32_t count, uint64_t now )
+{
+    uint64_t delay = 0;
+    int64_t tokens;
+
+    if ( ( pBucket != NULL ) &&
+         ( pBucket->rate != 0 ) )
+    {
+        Refill( pBucket, now );
+
+        tokens = Required( pBucket, (int64_t)count * BUCKET_TOKEN );
+        if ( pBucket->level < tokens )
+        {
+            /* round up so the tokens are available when the delay expires */
+            delay = ( tokens - pBucket->level + pBucket->rate - 1 )
+                    / pBucket->rate;
+        }
+    }
+
+    return delay;
+}
+
+/*==============================================================================
+        Private function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  Refill                                                                    */
+/*!
+    Refill a token bucket
+
+    The Refill function adds the tokens accumulated since the last
+    refill to the token bucket, up to its capacity.
+
+    @param[in]
+        pBucket
+            pointer to the token bucket
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+==============================================================================*/
+static void Refill( TokenBucket *pBucket, uint64_t now )
+{
+    uint64_t elapsed;
+    uint64_t full;
+
+    if ( now > pBucket->last )
+    {
+        elapsed = now - pBucket->last;
+
+        /* time to refill the bucket from its current level (or debt) */
+        full = (uint64_t)( pBucket->capacity - pBucket->level )
+               / pBucket->rate;
+
+        if ( elapsed > full )
+        {
+            pBucket->level = pBucket->capacity;
+        }
+        else
+        {
+            pBucket->level += (int64_t)elapsed * pBucket->rate;
+            if ( pBucket->level > pBucket->capacity )
+            {
+                pBucket->level = pBucket->capacity;
+            }
+        }
+
+        pBucket->last = now;
+    }
+}
+
+/*============================================================================*/
+/*  Required                                                                  */
+/*!
+    Get the level required to take tokens
+
+    The Required function gets the bucket level at which a request
+    for tokens can be granted.  This is the request itself, limited
+    to the bucket capacity so that any request can eventually be
+    granted.  The full request is still charged.
+
+    @param[in]
+        pBucket
+            pointer to the token bucket
+
+    @param[in]
+        tokens
+            number of millionths of a token requested
+
+    @retval required level in millionths of a token
+
+==============================================================================*/
+static int64_t Required( TokenBucket *pBucket, int64_t tokens )
+{
+    return ( tokens > pBucket->capacity ) ? pBucket->capacity : tokens;
+}
+
+/*! @}
+ * end of bucket group */
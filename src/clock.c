@@ -0,0 +1,144 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup clock clock
+ * @brief Scheduler clock for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file clock.c
+
+    Scheduler Clock
+
+    The scheduler clock is the time base for the sample deadlines,
+    the bus budget, the statistics publication and the device health
+    backoff.  It normally follows the monotonic clock.
+
+    The clock can instead be switched to a simulated clock which only
+    moves when it is advanced, so that hours of scheduler behavior can
+    be run in a fraction of a second without waiting for the deadlines.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include "timestamp.h"
+#include "clock.h"
+
+/*==============================================================================
+        Private file scoped variables
+==============================================================================*/
+
+/*! indicates if the simulated clock is in use */
+static bool simulated = false;
+
+/*! current simulated time in microseconds */
+static uint64_t simulatedNow = 0;
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  CLOCK_Now                                                                 */
+/*!
+    Get the current scheduler time
+
+    The CLOCK_Now function gets the current scheduler time.  This is
+    the monotonic time unless the simulated clock is in use.
+
+    @retval current scheduler time in microseconds
+
+==============================================================================*/
+uint64_t CLOCK_Now( void )
+{
+    return ( simulated == true ) ? simulatedNow : TIMESTAMP_Now();
+}
+
+/*============================================================================*/
+/*  CLOCK_Simulate                                                            */
+/*!
+    Switch to the simulated clock
+
+    The CLOCK_Simulate function switches the scheduler clock to the
+    simulated clock.  From then on, time only passes when the clock
+    is advanced with CLOCK_Advance.
+
+    @param[in]
+        start
+            initial simulated time in microseconds
+
+==============================================================================*/
+void CLOCK_Simulate( uint64_t start )
+{
+    simulatedNow = start;
+    simulated = true;
+}
+
+/*============================================================================*/
+/*  CLOCK_IsSimulated                                                         */
+/*!
+    Check if the simulated clock is in use
+
+    The CLOCK_IsSimulated function checks if the scheduler clock has
+    been switched to the simulated clock.
+
+    @retval true the simulated clock is in use
+    @retval false the scheduler clock follows the monotonic clock
+
+==============================================================================*/
+bool CLOCK_IsSimulated( void )
+{
+    return simulated;
+}
+
+/*============================================================================*/
+/*  CLOCK_Advance                                                             */
+/*!
+    Advance the simulated clock
+
+    The CLOCK_Advance function moves the simulated clock forward.
+    It has no effect on the monotonic clock.
+
+    @param[in]
+        interval
+            time to advance the clock by in microseconds
+
+==============================================================================*/
+void CLOCK_Advance( uint64_t interval )
+{
+    if ( simulated == true )
+    {
+        simulatedNow += interval;
+    }
+}
+
+/*! @}
+ * end of clock group */
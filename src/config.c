@@ -0,0 +1,1672 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup config config
+ * @brief Compiled configuration for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file config.c
+
+    Compiled Configuration
+
+    The config module compiles the ADS7830 JSON configuration into a
+    compact, position independent binary image.  The image can be
+    saved to a cache file and mapped directly back into memory on
+    the next start, avoiding the JSON parser entirely.
+
+    The cache file is versioned and protected by a checksum, and it
+    records the modification time and size of the JSON file it was
+    compiled from.  A cache file which is corrupt, from a different
+    format version, or older than its JSON source is rejected so the
+    caller can fall back to the JSON configuration.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "config.h"
+#include "lut.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*! initial allocation size for the string table */
+#define CONFIG_STRTAB_INITIAL_SIZE 256
+
+/*! statistics window samples for channels without a sampling interval */
+#define CONFIG_STATS_DEFAULT_SAMPLES 1024
+
+/*! maximum number of conversion table breakpoints */
+#define CONFIG_MAX_BREAKPOINTS LUT_SIZE
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _config_builder structure tracks a configuration
+    as it is being compiled */
+typedef struct _config_builder
+{
+    /*! pointer to the configuration being compiled */
+    Config *pConfig;
+
+    /*! allocated size of the configuration */
+    size_t capacity;
+
+    /*! compilation result */
+    int result;
+} ConfigBuilder;
+
+/*! the _breakpoint_list structure collects conversion table
+    breakpoints as they are parsed */
+typedef struct _breakpoint_list
+{
+    /*! number of breakpoints */
+    size_t n;
+
+    /*! breakpoints */
+    LUTPoint points[CONFIG_MAX_BREAKPOINTS];
+} BreakpointList;
+
+/*==============================================================================
+        Private function declarations
+==============================================================================*/
+
+static int ParseChannel( JNode *pNode, void *arg );
+static uint32_t ParseTable( ConfigBuilder *pBuilder, JNode *pNode );
+static int ParseBreakpoint( JNode *pNode, void *arg );
+static double GetDouble( JNode *pNode, char *key, double dflt );
+static int32_t GetPower( JNode *pNode, int32_t dflt );
+static int32_t GetBackend( JNode *pNode );
+static void ParseBudget( Config *pConfig, JNode *pNode );
+static void ParseScan( ConfigBuilder *pBuilder, JNode *pNode );
+static void ParseHealth( ConfigBuilder *pBuilder, JNode *pNode );
+static void ParseReplay( ConfigBuilder *pBuilder, JNode *pNode );
+static void ParseAdaptive( ConfigChannel *pChannel, JNode *pNode );
+static int ParseAlarm( ConfigBuilder *pBuilder, int channel, JNode *pNode );
+static void ParseStats( ConfigChannel *pChannel, JNode *pNode );
+static uint32_t AddString( ConfigBuilder *pBuilder, char *str );
+static uint32_t AddData( ConfigBuilder *pBuilder,
+                         const void *pData,
+                         size_t len,
+                         size_t align );
+static uint32_t Checksum( Config *pConfig );
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  CONFIG_Compile                                                            */
+/*!
+    Compile a JSON configuration
+
+    The CONFIG_Compile function compiles a parsed JSON configuration
+    into a binary configuration image.  The JSON configuration is
+    not referenced by the image and may be released afterwards.
+
+    @param[in]
+        pNode
+            pointer to the root of the JSON configuration
+
+    @param[in]
+        pFileName
+            name of the JSON configuration file
+
+    @param[in,out]
+        pImage
+            pointer to the configuration image to populate
+
+    @retval EOK the configuration was compiled
+    @retval ENOMEM memory allocation failed
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+int CONFIG_Compile( JNode *pNode, char *pFileName, ConfigImage *pImage )
+{
+    int result = EINVAL;
+    ConfigBuilder builder;
+    JArray *pArray;
+    char *attr;
+    struct stat sb;
+    Config *pConfig;
+    uint32_t offset;
+    int ch;
+
+    if ( ( pNode != NULL ) &&
+         ( pImage != NULL ) )
+    {
+        builder.capacity = sizeof( Config ) + CONFIG_STRTAB_INITIAL_SIZE;
+        builder.pConfig = calloc( 1, builder.capacity );
+        builder.result = EOK;
+
+        if ( builder.pConfig != NULL )
+        {
+            /* offset 0 is reserved for "no string" */
+            builder.pConfig->strtabSize = 1;
+
+            /* get the default power-down mode */
+            builder.pConfig->power = GetPower( pNode, CONFIG_POWER_ADC );
+
+            /* get the bus transaction budget */
+            ParseBudget( builder.pConfig, JSON_Find( pNode, "budget" ) );
+
+            /* get the packed scan variable (if any) */
+            ParseScan( &builder, JSON_Find( pNode, "scan" ) );
+
+            /* get the device health settings */
+            ParseHealth( &builder, JSON_Find( pNode, "health" ) );
+
+            /* set up the default channel conversion */
+            for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+            {
+                builder.pConfig->channels[ch].power = builder.pConfig->power;
+                builder.pConfig->channels[ch].vref =
+                    ( builder.pConfig->power & CONFIG_POWER_REF )
+                        ? CONFIG_INTERNAL_VREF
+                        : CONFIG_DEFAULT_VREF;
+                builder.pConfig->channels[ch].scale = 1.0f;
+            }
+
+            /* get the name of the i2c device */
+            builder.pConfig->device = AddString( &builder,
+                                                 JSON_GetStr( pNode,
+                                                              "device" ) );
+
+            /* get the address of the i2c device */
+            attr = JSON_GetStr( pNode, "address" );
+            builder.pConfig->address = ( attr != NULL )
+                                       ? strtoul( attr, NULL, 16 )
+                                       : 0;
+
+            /* get the i2c adapter timeout and retry count */
+            attr = JSON_GetStr( pNode, "timeout_ms" );
+            builder.pConfig->timeout = ( attr != NULL ) ? atoi( attr ) : 0;
+
+            attr = JSON_GetStr( pNode, "retries" );
+            builder.pConfig->retries = ( attr != NULL ) ? atoi( attr ) : -1;
+
+            /* get the data source backend */
+            builder.pConfig->backend = GetBackend( pNode );
+
+            /* get the sysfs device directory of the kernel driver */
+            offset = AddString( &builder, JSON_GetStr( pNode, "sysfs" ) );
+            builder.pConfig->sysfs = offset;
+
+            /* get the replay recording (if any) */
+            ParseReplay( &builder, JSON_Find( pNode, "replay" ) );
+
+            /* compile the channel definitions */
+            pArray = (JArray *)JSON_Find( pNode, "channels" );
+            JSON_Iterate( pArray, ParseChannel, (void *)&builder );
+
+            /* keep the string table NUL terminated after any tables */
+            (void)AddString( &builder, "" );
+
+            result = builder.result;
+        }
+        else
+        {
+            result = ENOMEM;
+        }
+
+        if ( result == EOK )
+        {
+            pConfig = builder.pConfig;
+            pConfig->magic = CONFIG_MAGIC;
+            pConfig->version = CONFIG_VERSION;
+            pConfig->size = offsetof( Config, strtab ) + pConfig->strtabSize;
+
+            /* record the source file so a stale cache can be detected */
+            if ( ( pFileName != NULL ) &&
+                 ( stat( pFileName, &sb ) == 0 ) )
+            {
+                pConfig->srcMtime = ( (int64_t)sb.st_mtim.tv_sec
+                                      * 1000000000LL )
+                                    + sb.st_mtim.tv_nsec;
+                pConfig->srcSize = sb.st_size;
+            }
+
+            pConfig->checksum = Checksum( pConfig );
+
+            pImage->pConfig = pConfig;
+            pImage->size = builder.capacity;
+            pImage->mapped = false;
+        }
+        else
+        {
+            free( builder.pConfig );
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  CONFIG_Load                                                               */
+/*!
+    Load a compiled configuration from a cache file
+
+    The CONFIG_Load function maps a compiled configuration cache file
+    into memory and validates it.
+
+    @param[in]
+        pCacheFile
+            name of the compiled configuration cache file
+
+    @param[in]
+        pFileName
+            name of the JSON configuration file the cache was
+            compiled from.  If it is newer than the cache, the
+            cache is rejected as stale.
+
+    @param[in,out]
+        pImage
+            pointer to the configuration image to populate
+
+    @retval EOK the configuration was loaded
+    @retval ESTALE the cache is older than its JSON source
+    @retval EILSEQ the cache is corrupt or from another format version
+    @retval EINVAL invalid arguments
+    @retval other error from open, fstat or mmap
+
+==============================================================================*/
+int CONFIG_Load( char *pCacheFile, char *pFileName, ConfigImage *pImage )
+{
+    int result = EINVAL;
+    int fd;
+    struct stat sb;
+    Config *pConfig;
+    size_t mapLen = 0;
+    int64_t mtime;
+
+    if ( ( pCacheFile != NULL ) &&
+         ( pImage != NULL ) )
+    {
+        fd = open( pCacheFile, O_RDONLY );
+        if ( fd != -1 )
+        {
+            if ( fstat( fd, &sb ) != 0 )
+            {
+                result = errno;
+            }
+            else if ( (size_t)sb.st_size < sizeof( Config ) )
+            {
+                result = EILSEQ;
+            }
+            else
+            {
+                /* the size in the file cannot be trusted until verified */
+                mapLen = (size_t)sb.st_size;
+                pConfig = mmap( NULL,
+                                mapLen,
+                                PROT_READ,
+                                MAP_PRIVATE,
+                                fd,
+                                0 );
+                result = ( pConfig != MAP_FAILED ) ? EOK : errno;
+            }
+
+            close( fd );
+        }
+        else
+        {
+            result = errno;
+        }
+
+        if ( result == EOK )
+        {
+            if ( ( pConfig->magic != CONFIG_MAGIC ) ||
+                 ( pConfig->version != CONFIG_VERSION ) ||
+                 ( pConfig->size != (uint32_t)sb.st_size ) ||
+                 ( pConfig->strtabSize == 0 ) ||
+                 ( offsetof( Config, strtab ) + pConfig->strtabSize
+                    != pConfig->size ) ||
+                 ( pConfig->strtab[pConfig->strtabSize - 1] != '\0' ) ||
+                 ( pConfig->checksum != Checksum( pConfig ) ) )
+            {
+                result = EILSEQ;
+            }
+            else if ( ( pFileName != NULL ) &&
+                      ( stat( pFileName, &sb ) == 0 ) )
+            {
+                mtime = ( (int64_t)sb.st_mtim.tv_sec * 1000000000LL )
+                        + sb.st_mtim.tv_nsec;
+                if ( ( mtime != pConfig->srcMtime ) ||
+                     ( sb.st_size != pConfig->srcSize ) )
+                {
+                    result = ESTALE;
+                }
+            }
+
+            if ( result == EOK )
+            {
+                pImage->pConfig = pConfig;
+                pImage->size = pConfig->size;
+                pImage->mapped = true;
+            }
+            else
+            {
+                munmap( pConfig, mapLen );
+            }
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  CONFIG_Save                                                               */
+/*!
+    Save a compiled configuration to a cache file
+
+    The CONFIG_Save function writes a compiled configuration to a
+    cache file.  The file is written under a temporary name and then
+    renamed so a partially written cache is never observed.
+
+    @param[in]
+        pImage
+            pointer to the configuration image to save
+
+    @param[in]
+        pCacheFile
+            name of the compiled configuration cache file
+
+    @retval EOK the configuration was saved
+    @retval EINVAL invalid arguments
+    @retval other error from open, write or rename
+
+==============================================================================*/
+int CONFIG_Save( ConfigImage *pImage, char *pCacheFile )
+{
+    int result = EINVAL;
+    char tmpname[BUFSIZ];
+    int fd;
+    ssize_t n;
+
+    if ( ( pImage != NULL ) &&
+         ( pImage->pConfig != NULL ) &&
+         ( pCacheFile != NULL ) )
+    {
+        snprintf( tmpname, sizeof( tmpname ), "%s.tmp", pCacheFile );
+
+        fd = open( tmpname, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+        if ( fd != -1 )
+        {
+            n = write( fd, pImage->pConfig, pImage->pConfig->size );
+            if ( n == (ssize_t)pImage->pConfig->size )
+            {
+                result = EOK;
+            }
+            else
+            {
+                result = ( n < 0 ) ? errno : EIO;
+            }
+
+            close( fd );
+
+            if ( result == EOK )
+            {
+                if ( rename( tmpname, pCacheFile ) != 0 )
+                {
+                    result = errno;
+                }
+            }
+
+            if ( result != EOK )
+            {
+                unlink( tmpname );
+            }
+        }
+        else
+        {
+            result = errno;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  CONFIG_Release                                                            */
+/*!
+    Release a configuration image
+
+    The CONFIG_Release function releases the storage associated with
+    a configuration image.
+
+    @param[in]
+        pImage
+            pointer to the configuration image to release
+
+==============================================================================*/
+void CONFIG_Release( ConfigImage *pImage )
+{
+    if ( ( pImage != NULL ) &&
+         ( pImage->pConfig != NULL ) )
+    {
+        if ( pImage->mapped == true )
+        {
+            munmap( pImage->pConfig, pImage->size );
+        }
+        else
+        {
+            free( pImage->pConfig );
+        }
+
+        pImage->pConfig = NULL;
+        pImage->size = 0;
+        pImage->mapped = false;
+    }
+}
+
+/*============================================================================*/
+/*  CONFIG_GetStr                                                             */
+/*!
+    Get a string from the configuration string table
+
+    The CONFIG_GetStr function gets a pointer to a string in the
+    configuration string table.
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+    @param[in]
+        offset
+            string table offset of the string
+
+    @retval pointer to the string
+    @retval NULL if the offset is 0 or invalid
+
+==============================================================================*/
+char *CONFIG_GetStr( Config *pConfig, uint32_t offset )
+{
+    char *str = NULL;
+
+    if ( ( pConfig != NULL ) &&
+         ( offset > 0 ) &&
+         ( offset < pConfig->strtabSize ) )
+    {
+        str = &pConfig->strtab[offset];
+    }
+
+    return str;
+}
+
+/*==============================================================================
+        Private function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  CONFIG_GetTable                                                           */
+/*!
+    Get a conversion table from a compiled configuration
+
+    The CONFIG_GetTable function gets a pointer to a LUT_SIZE entry
+    conversion table in the string table of a compiled configuration.
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+    @param[in]
+        offset
+            string table offset of the conversion table
+
+    @retval pointer to the conversion table
+    @retval NULL if the offset is 0 or invalid
+
+==============================================================================*/
+const float *CONFIG_GetTable( Config *pConfig, uint32_t offset )
+{
+    const float *pTable = NULL;
+    size_t pos;
+
+    if ( ( pConfig != NULL ) &&
+         ( offset != 0 ) &&
+         ( offset < pConfig->strtabSize ) &&
+         ( pConfig->strtabSize - offset >= LUT_SIZE * sizeof( float ) ) )
+    {
+        pos = offsetof( Config, strtab ) + offset;
+        if ( ( pos % sizeof( float ) ) == 0 )
+        {
+            pTable = (const float *)&pConfig->strtab[offset];
+        }
+    }
+
+    return pTable;
+}
+
+/*============================================================================*/
+/*  ParseChannel                                                              */
+/*!
+    Parse an ADS7830 channel definition
+
+    The ParseChannel function is a callback function for the JSON_Iterate
+    function which parses an ADS7830 channel definition object.
+    The channel definition object is expected to look as follows:
+
+    {
+      "channel" : "3",
+      "var" : "/HW/ADS7830/A3",
+      "interval" : "1000",
+      "adaptive" : { ... },
+      "input" : "single",
+      "power" : "adc",
+      "vref" : "3.3",
+      "scale" : "2.0",
+      "offset" : "-0.5",
+      "units" : "V",
+      "decimals" : "3",
+      "table" : { ... },
+      "alarm" : { ... },
+      "stats" : { ... }
+    }
+
+    If "interval" is not specified or set to 0, then the channnel will
+    be sampled on demand via a CALC notification.
+
+    The optional "adaptive" object varies the sampling interval with
+    the signal activity (see ParseAdaptive).
+
+    The optional "input" attribute selects a "single" ended input
+    (the default), or a "differential" input measured against the
+    other channel of its pair (e.g. channel 3 measures CH3+ against
+    CH2-, and channel 2 measures CH2+ against CH3-).
+
+    The optional "power" attribute overrides the device power-down
+    mode after each conversion of the channel (see GetPower).
+
+    The optional "vref", "scale" and "offset" attributes define the
+    conversion from counts to engineering units.  The default "vref"
+    is the internal reference voltage if the power-down mode keeps
+    the internal reference on.
+
+        value = ( ( counts / 255 ) * vref * scale ) + offset
+
+    The optional "decimals" attribute selects fixed-point publication
+    to integer variables, with up to CONFIG_MAX_DECIMALS decimal places.
+
+    The optional "table" object replaces the linear conversion with
+    a conversion table (see ParseTable).
+
+    The optional "alarm" object defines a threshold alarm on the
+    channel (see ParseAlarm).
+
+    The optional "stats" object enables rolling window statistics
+    on the channel (see ParseStats).
+
+    @param[in]
+       pNode
+            pointer to the channel node
+
+    @param[in]
+        arg
+            opaque pointer argument used for the configuration builder
+
+    @retval EOK - the channel object was parsed successfully
+    @retval EINVAL - the channel object could not be parsed
+
+==============================================================================*/
+static int ParseChannel( JNode *pNode, void *arg )
+{
+    int result = EINVAL;
+    ConfigBuilder *pBuilder = (ConfigBuilder *)arg;
+    ConfigChannel *pChannel;
+    int channel;
+    char *attr;
+    uint32_t var;
+    uint32_t units;
+    uint32_t table;
+
+    if ( ( pNode != NULL ) &&
+         ( pBuilder != NULL ) )
+    {
+        /* get the mandatory channel index */
+        attr = JSON_GetStr( pNode, "channel" );
+        channel = attr != NULL ? atoi( attr ) : -1;
+
+        if( ( channel >= 0 ) &&
+            ( channel < ADS7830_NUM_CHANNELS ) )
+        {
+            /* add the strings first since they may move the config */
+            var = AddString( pBuilder, JSON_GetStr( pNode, "var" ) );
+            units = AddString( pBuilder, JSON_GetStr( pNode, "units" ) );
+            table = ParseTable( pBuilder, JSON_Find( pNode, "table" ) );
+
+            pChannel = &pBuilder->pConfig->channels[channel];
+            pChannel->var = var;
+            pChannel->units = units;
+            pChannel->table = table;
+
+            /* get the sampling interval (if any) */
+            attr = JSON_GetStr( pNode, "interval" );
+            pChannel->interval = ( attr != NULL ) ? atoi( attr ) : 0;
+
+            /* get the adaptive sampling interval (if any) */
+            ParseAdaptive( pChannel, JSON_Find( pNode, "adaptive" ) );
+
+            /* get the input mode */
+            attr = JSON_GetStr( pNode, "input" );
+            if ( ( attr != NULL ) && ( strcmp( attr, "differential" ) == 0 ) )
+            {
+                pChannel->input = CONFIG_INPUT_DIFFERENTIAL;
+            }
+            else
+            {
+                if ( ( attr != NULL ) && ( strcmp( attr, "single" ) != 0 ) )
+                {
+                    fprintf( stderr, "unknown input mode: %s\n", attr );
+                }
+
+                pChannel->input = CONFIG_INPUT_SINGLE_ENDED;
+            }
+
+            /* get the power-down mode */
+            pChannel->power = GetPower( pNode, pBuilder->pConfig->power );
+
+            /* get the engineering unit conversion (if any) */
+            attr = JSON_GetStr( pNode, "vref" );
+            if ( attr != NULL )
+            {
+                pChannel->vref = strtof( attr, NULL );
+            }
+            else if ( pChannel->power & CONFIG_POWER_REF )
+            {
+                /* use the internal reference */
+                pChannel->vref = CONFIG_INTERNAL_VREF;
+            }
+            else
+            {
+                pChannel->vref = CONFIG_DEFAULT_VREF;
+            }
+
+            attr = JSON_GetStr( pNode, "scale" );
+            if ( attr != NULL )
+            {
+                pChannel->scale = strtof( attr, NULL );
+            }
+
+            attr = JSON_GetStr( pNode, "offset" );
+            if ( attr != NULL )
+            {
+                pChannel->offset = strtof( attr, NULL );
+            }
+
+            attr = JSON_GetStr( pNode, "decimals" );
+            pChannel->decimals = ( attr != NULL ) ? atoi( attr ) : 0;
+            if ( ( pChannel->decimals < 0 ) ||
+                 ( pChannel->decimals > CONFIG_MAX_DECIMALS ) )
+            {
+                fprintf( stderr, "decimals out of range: %s\n", attr );
+                pChannel->decimals = ( pChannel->decimals < 0 )
+                                     ? 0
+                                     : CONFIG_MAX_DECIMALS;
+            }
+
+            /* get the rolling window statistics (if any) */
+            ParseStats( pChannel, JSON_Find( pNode, "stats" ) );
+
+            /* get the threshold alarm (if any) */
+            result = ParseAlarm( pBuilder,
+                                 channel,
+                                 JSON_Find( pNode, "alarm" ) );
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ParseTable                                                                */
+/*!
+    Parse a channel conversion table definition
+
+    The ParseTable function builds a LUT_SIZE entry conversion table
+    from counts to engineering units and adds it to the configuration
+    being compiled.  The table is built from either a list of breakpoints:
+
+    {
+      "type" : "breakpoints",
+      "points" : [
+          { "counts" : "0", "value" : "0.0" },
+          { "counts" : "128", "value" : "20.0" },
+          { "counts" : "255", "value" : "100.0" }
+      ]
+    }
+
+    or from the Steinhart-Hart coefficients of an NTC thermistor in
+    a divider with a series resistor:
+
+    {
+      "type" : "thermistor",
+      "rseries" : "10000",
+      "a" : "1.009249522e-03",
+      "b" : "2.378405444e-04",
+      "c" : "2.019202697e-07"
+    }
+
+    A thermistor may alternatively be specified by its "beta",
+    "r0" and "t0" (degrees Celsius) values.
+
+    Channels with a conversion table ignore the "vref", "scale"
+    and "offset" attributes.
+
+    @param[in]
+        pBuilder
+            pointer to the configuration builder
+
+    @param[in]
+        pNode
+            pointer to the table definition node (may be NULL)
+
+    @retval string table offset of the conversion table
+    @retval 0 if no table is defined or the table is invalid
+
+==============================================================================*/
+static uint32_t ParseTable( ConfigBuilder *pBuilder, JNode *pNode )
+{
+    uint32_t offset = 0;
+    float table[LUT_SIZE];
+    BreakpointList *pList;
+    LUTThermistor thermistor;
+    char *type;
+    int rc = EINVAL;
+
+    if ( ( pBuilder != NULL ) &&
+         ( pNode != NULL ) )
+    {
+        type = JSON_GetStr( pNode, "type" );
+        if ( type == NULL )
+        {
+            fprintf( stderr, "conversion table type not specified\n" );
+        }
+        else if ( strcmp( type, "breakpoints" ) == 0 )
+        {
+            pList = calloc( 1, sizeof( BreakpointList ) );
+            if ( pList != NULL )
+            {
+                JSON_Iterate( (JArray *)JSON_Find( pNode, "points" ),
+                              ParseBreakpoint,
+                              (void *)pList );
+                rc = LUT_Breakpoints( pList->points, pList->n, table );
+                free( pList );
+            }
+            else
+            {
+                pBuilder->result = ENOMEM;
+            }
+        }
+        else if ( strcmp( type, "thermistor" ) == 0 )
+        {
+            thermistor.rseries = GetDouble( pNode, "rseries", 0.0 );
+            thermistor.a = GetDouble( pNode, "a", 0.0 );
+            thermistor.b = GetDouble( pNode, "b", 0.0 );
+            thermistor.c = GetDouble( pNode, "c", 0.0 );
+            thermistor.beta = GetDouble( pNode, "beta", 0.0 );
+            thermistor.r0 = GetDouble( pNode, "r0", 0.0 );
+            thermistor.t0 = GetDouble( pNode, "t0", 25.0 );
+            rc = LUT_Thermistor( &thermistor, table );
+        }
+        else
+        {
+            fprintf( stderr, "unknown conversion table type: %s\n", type );
+        }
+
+        if ( rc == EOK )
+        {
+            offset = AddData( pBuilder, table, sizeof( table ), sizeof( float ) );
+        }
+        else
+        {
+            fprintf( stderr, "invalid conversion table\n" );
+        }
+    }
+
+    return offset;
+}
+
+/*============================================================================*/
+/*  ParseBreakpoint                                                           */
+/*!
+    Parse a conversion table breakpoint
+
+    The ParseBreakpoint function is a callback function for the
+    JSON_Iterate function which parses a conversion table breakpoint
+    object containing "counts" and "value" attributes.
+
+    @param[in]
+       pNode
+            pointer to the breakpoint node
+
+    @param[in]
+        arg
+            opaque pointer argument used for the breakpoint list
+
+    @retval EOK - the breakpoint was parsed successfully
+    @retval EINVAL - the breakpoint could not be parsed
+
+==============================================================================*/
+static int ParseBreakpoint( JNode *pNode, void *arg )
+{
+    int result = EINVAL;
+    BreakpointList *pList = (BreakpointList *)arg;
+    char *counts;
+    char *value;
+
+    if ( ( pNode != NULL ) &&
+         ( pList != NULL ) &&
+         ( pList->n < CONFIG_MAX_BREAKPOINTS ) )
+    {
+        counts = JSON_GetStr( pNode, "counts" );
+        value = JSON_GetStr( pNode, "value" );
+        if ( ( counts != NULL ) && ( value != NULL ) )
+        {
+            pList->points[pList->n].counts = strtof( counts, NULL );
+            pList->points[pList->n].value = strtof( value, NULL );
+            pList->n++;
+            result = EOK;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  GetDouble                                                                 */
+/*!
+    Get a floating point attribute
+
+    The GetDouble function gets a floating point attribute from
+    a JSON object.
+
+    @param[in]
+        pNode
+            pointer to the JSON object
+
+    @param[in]
+        key
+            name of the attribute
+
+    @param[in]
+        dflt
+            value to return if the attribute is not specified
+
+    @retval the attribute value
+
+==============================================================================*/
+static double GetDouble( JNode *pNode, char *key, double dflt )
+{
+    char *attr = JSON_GetStr( pNode, key );
+
+    return ( attr != NULL ) ? strtod( attr, NULL ) : dflt;
+}
+
+/*============================================================================*/
+/*  GetPower                                                                  */
+/*!
+    Get a power-down mode attribute
+
+    The GetPower function gets the "power" attribute from a JSON object.
+    The power-down mode selects what remains powered between conversions:
+
+        "down" - power down the reference and A/D converter
+        "adc"  - keep the A/D converter on, internal reference off
+        "ref"  - keep the internal reference on, A/D converter off
+        "on"   - keep the internal reference and A/D converter on
+
+    Keeping the converter and reference on avoids the wake-up settling
+    time between back-to-back conversions, and powering down minimizes
+    the supply current between sparse samples.
+
+    @param[in]
+        pNode
+            pointer to the JSON object
+
+    @param[in]
+        dflt
+            power-down mode to return if the attribute is not specified
+
+    @retval the power-down mode (see ConfigPower)
+
+==============================================================================*/
+static int32_t GetPower( JNode *pNode, int32_t dflt )
+{
+    int32_t power = dflt;
+    char *attr = JSON_GetStr( pNode, "power" );
+
+    if ( attr != NULL )
+    {
+        if ( strcmp( attr, "down" ) == 0 )
+        {
+            power = CONFIG_POWER_DOWN;
+        }
+        else if ( strcmp( attr, "adc" ) == 0 )
+        {
+            power = CONFIG_POWER_ADC;
+        }
+        else if ( strcmp( attr, "ref" ) == 0 )
+        {
+            power = CONFIG_POWER_REF;
+        }
+        else if ( strcmp( attr, "on" ) == 0 )
+        {
+            power = CONFIG_POWER_ON;
+        }
+        else
+        {
+            fprintf( stderr, "unknown power mode: %s\n", attr );
+        }
+    }
+
+    return power;
+}
+
+/*============================================================================*/
+/*  GetBackend                                                                */
+/*!
+    Get the data source backend
+
+    The GetBackend function gets the "backend" attribute from the
+    JSON configuration, which selects how the channels are read:
+
+        "i2c"   - i2c-dev write and read system calls (default)
+        "uring" - i2c-dev transfers batched through io_uring
+        "hwmon" - inputs of the kernel hwmon driver in millivolts
+        "iio"   - raw inputs of a kernel IIO driver
+        "replay" - recorded samples played back from a file
+
+    @param[in]
+        pNode
+            pointer to the JSON object
+
+    @retval the data source backend (see ConfigBackend)
+
+==============================================================================*/
+static int32_t GetBackend( JNode *pNode )
+{
+    int32_t backend = CONFIG_BACKEND_I2C;
+    char *attr = JSON_GetStr( pNode, "backend" );
+
+    if ( attr != NULL )
+    {
+        if ( strcmp( attr, "uring" ) == 0 )
+        {
+            backend = CONFIG_BACKEND_URING;
+        }
+        else if ( strcmp( attr, "hwmon" ) == 0 )
+        {
+            backend = CONFIG_BACKEND_HWMON;
+        }
+        else if ( strcmp( attr, "iio" ) == 0 )
+        {
+            backend = CONFIG_BACKEND_IIO;
+        }
+        else if ( strcmp( attr, "replay" ) == 0 )
+        {
+            backend = CONFIG_BACKEND_REPLAY;
+        }
+        else if ( strcmp( attr, "i2c" ) != 0 )
+        {
+            fprintf( stderr, "unknown backend: %s\n", attr );
+        }
+    }
+
+    return backend;
+}
+
+/*============================================================================*/
+/*  ParseBudget                                                               */
+/*!
+    Parse the bus transaction budget
+
+    The ParseBudget function parses the optional bus transaction budget
+    object, which limits the rate of I2C transactions on a shared bus:
+
+    {
+      "rate" : "200",
+      "burst" : "8",
+      "policy" : "stretch"
+    }
+
+    The "rate" is in transactions per second, and "burst" is the number
+    of transactions which may be issued back to back (one scan of all
+    channels by default).  The "policy" selects whether periodic samples
+    which exceed the budget are skipped ("drop", the default) or delayed
+    ("stretch").
+
+    @param[in,out]
+        pConfig
+            pointer to the configuration being compiled
+
+    @param[in]
+        pNode
+            pointer to the budget node (may be NULL)
+
+==============================================================================*/
+static void ParseBudget( Config *pConfig, JNode *pNode )
+{
+    char *attr;
+
+    pConfig->budgetRate = 0;
+    pConfig->budgetBurst = ADS7830_NUM_CHANNELS;
+    pConfig->budgetPolicy = CONFIG_BUDGET_DROP;
+
+    if ( pNode != NULL )
+    {
+        attr = JSON_GetStr( pNode, "rate" );
+        if ( attr != NULL )
+        {
+            pConfig->budgetRate = strtoul( attr, NULL, 0 );
+        }
+
+        attr = JSON_GetStr( pNode, "burst" );
+        if ( attr != NULL )
+        {
+            pConfig->budgetBurst = strtoul( attr, NULL, 0 );
+        }
+
+        attr = JSON_GetStr( pNode, "policy" );
+        if ( ( attr != NULL ) && ( strcmp( attr, "stretch" ) == 0 ) )
+        {
+            pConfig->budgetPolicy = CONFIG_BUDGET_STRETCH;
+        }
+        else if ( ( attr != NULL ) && ( strcmp( attr, "drop" ) != 0 ) )
+        {
+            fprintf( stderr, "unknown budget policy: %s\n", attr );
+        }
+    }
+}
+
+/*============================================================================*/
+/*  ParseAdaptive                                                             */
+/*!
+    Parse a channel adaptive sampling definition
+
+    The ParseAdaptive function parses the optional adaptive sampling
+    object of a channel:
+
+    {
+      "min" : "10",
+      "max" : "1000",
+      "threshold" : "2"
+    }
+
+    When the change between consecutive samples exceeds "threshold"
+    counts, the sampling interval drops to "min" milliseconds to
+    capture the transient.  While the signal is quiet, the interval
+    relaxes back towards "max" milliseconds.  A channel with an
+    adaptive interval and no "interval" starts at the maximum interval.
+
+    @param[in,out]
+        pChannel
+            pointer to the channel definition being compiled
+
+    @param[in]
+        pNode
+            pointer to the adaptive node (may be NULL)
+
+==============================================================================*/
+static void ParseAdaptive( ConfigChannel *pChannel, JNode *pNode )
+{
+    char *attr;
+
+    pChannel->adaptMin = 0;
+    pChannel->adaptMax = 0;
+    pChannel->adaptThreshold = 0;
+
+    if ( pNode != NULL )
+    {
+        attr = JSON_GetStr( pNode, "min" );
+        pChannel->adaptMin = ( attr != NULL ) ? atoi( attr ) : 0;
+
+        attr = JSON_GetStr( pNode, "max" );
+        pChannel->adaptMax = ( attr != NULL ) ? atoi( attr ) : 0;
+
+        attr = JSON_GetStr( pNode, "threshold" );
+        pChannel->adaptThreshold = ( attr != NULL ) ? atoi( attr ) : 0;
+
+        if ( ( pChannel->adaptMin <= 0 ) ||
+             ( pChannel->adaptMax < pChannel->adaptMin ) )
+        {
+            fprintf( stderr, "invalid adaptive interval\n" );
+            pChannel->adaptMin = 0;
+            pChannel->adaptMax = 0;
+        }
+        else if ( pChannel->interval == 0 )
+        {
+            pChannel->interval = pChannel->adaptMax;
+        }
+    }
+}
+
+/*============================================================================*/
+/*  ParseAlarm                                                                */
+/*!
+    Parse a channel threshold alarm definition
+
+    The ParseAlarm function parses the optional threshold alarm object
+    of a channel:
+
+    {
+      "var" : "/HW/ADS7830/A1/ALARM",
+      "high" : "3.0",
+      "low" : "0.5",
+      "hysteresis" : "0.1",
+      "duration" : "500"
+    }
+
+    The limits and hysteresis are in engineering units.  At least one
+    of "high" and "low" must be specified.  An alarm transition is only
+    reported once it has persisted for "duration" milliseconds.  If no
+    "var" is specified, the alarm is published to the "<var>/ALARM"
+    variable of the channel.
+
+    @param[in]
+        pBuilder
+            pointer to the configuration builder
+
+    @param[in]
+        channel
+            the channel number [0..7]
+
+    @param[in]
+        pNode
+            pointer to the alarm node (may be NULL)
+
+    @retval EOK the alarm was parsed (or not specified)
+    @retval EINVAL the alarm has no limits
+
+==============================================================================*/
+static int ParseAlarm( ConfigBuilder *pBuilder, int channel, JNode *pNode )
+{
+    int result = EOK;
+    ConfigChannel *pChannel;
+    uint32_t var;
+    char *attr;
+
+    if ( pNode != NULL )
+    {
+        /* add the string first since it may move the config */
+        var = AddString( pBuilder, JSON_GetStr( pNode, "var" ) );
+
+        pChannel = &pBuilder->pConfig->channels[channel];
+        pChannel->alarmVar = var;
+        pChannel->alarmLimits = 0;
+
+        attr = JSON_GetStr( pNode, "high" );
+        if ( attr != NULL )
+        {
+            pChannel->alarmHigh = strtof( attr, NULL );
+            pChannel->alarmLimits |= CONFIG_ALARM_HIGH;
+        }
+
+        attr = JSON_GetStr( pNode, "low" );
+        if ( attr != NULL )
+        {
+            pChannel->alarmLow = strtof( attr, NULL );
+            pChannel->alarmLimits |= CONFIG_ALARM_LOW;
+        }
+
+        attr = JSON_GetStr( pNode, "hysteresis" );
+        pChannel->alarmHysteresis = ( attr != NULL )
+                                    ? strtof( attr, NULL )
+                                    : 0.0f;
+
+        attr = JSON_GetStr( pNode, "duration" );
+        pChannel->alarmDuration = ( attr != NULL ) ? atoi( attr ) : 0;
+
+        if ( pChannel->alarmLimits == 0 )
+        {
+            fprintf( stderr, "alarm on channel %d has no limits\n", channel );
+            result = EINVAL;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ParseStats                                                                */
+/*!
+    Parse a channel rolling window statistics definition
+
+    The ParseStats function parses the optional rolling window
+    statistics object of a channel:
+
+    {
+      "window" : "60000",
+      "interval" : "1000",
+      "samples" : "600"
+    }
+
+    The minimum, maximum, mean and standard deviation of the samples
+    taken in the last "window" milliseconds are published every
+    "interval" milliseconds (once per window by default).  The optional
+    "samples" attribute sets the maximum number of samples held in the
+    window, which by default is calculated from the window length and
+    the (minimum) sampling interval of the channel.
+
+    @param[in,out]
+        pChannel
+            pointer to the channel definition being compiled
+
+    @param[in]
+        pNode
+            pointer to the statistics node (may be NULL)
+
+==============================================================================*/
+static void ParseStats( ConfigChannel *pChannel, JNode *pNode )
+{
+    char *attr;
+    int32_t interval;
+
+    pChannel->statsWindow = 0;
+    pChannel->statsInterval = 0;
+    pChannel->statsSamples = 0;
+
+    if ( pNode != NULL )
+    {
+        attr = JSON_GetStr( pNode, "window" );
+        pChannel->statsWindow = ( attr != NULL ) ? atoi( attr ) : 0;
+
+        attr = JSON_GetStr( pNode, "interval" );
+        pChannel->statsInterval = ( attr != NULL )
+                                  ? atoi( attr )
+                                  : pChannel->statsWindow;
+
+        attr = JSON_GetStr( pNode, "samples" );
+        if ( attr != NULL )
+        {
+            pChannel->statsSamples = strtoul( attr, NULL, 0 );
+        }
+        else
+        {
+            /* size the window for the fastest sampling interval */
+            interval = ( pChannel->adaptMax != 0 )
+                       ? pChannel->adaptMin
+                       : pChannel->interval;
+
+            pChannel->statsSamples = ( interval > 0 )
+                                     ? ( pChannel->statsWindow / interval ) + 1
+                                     : CONFIG_STATS_DEFAULT_SAMPLES;
+        }
+
+        if ( ( pChannel->statsWindow <= 0 ) ||
+             ( pChannel->statsInterval <= 0 ) ||
+             ( pChannel->statsSamples == 0 ) )
+        {
+            fprintf( stderr, "invalid statistics window\n" );
+            pChannel->statsWindow = 0;
+        }
+    }
+}
+
+/*============================================================================*/
+/*  ParseScan                                                                 */
+/*!
+    Parse the packed scan definition
+
+    The ParseScan function parses the optional packed scan object,
+    which publishes a snapshot of all the channels to a single string
+    variable every "interval" milliseconds:
+
+    {
+      "var" : "/HW/ADS7830/SCAN",
+      "interval" : "100"
+    }
+
+    @param[in]
+        pBuilder
+            pointer to the configuration builder
+
+    @param[in]
+        pNode
+            pointer to the scan node (may be NULL)
+
+==============================================================================*/
+static void ParseScan( ConfigBuilder *pBuilder, JNode *pNode )
+{
+    uint32_t var;
+    char *attr;
+
+    if ( pNode != NULL )
+    {
+        /* add the string first since it may move the config */
+        var = AddString( pBuilder, JSON_GetStr( pNode, "var" ) );
+        pBuilder->pConfig->scanVar = var;
+
+        attr = JSON_GetStr( pNode, "interval" );
+        pBuilder->pConfig->scanInterval = ( attr != NULL ) ? atoi( attr ) : 0;
+
+        if ( ( var == 0 ) || ( pBuilder->pConfig->scanInterval <= 0 ) )
+        {
+            fprintf( stderr, "invalid scan definition\n" );
+            pBuilder->pConfig->scanVar = 0;
+            pBuilder->pConfig->scanInterval = 0;
+        }
+    }
+}
+
+/*============================================================================*/
+/*  ParseHealth                                                               */
+/*!
+    Parse the device health settings
+
+    The ParseHealth function parses the optional device health object,
+    which controls how a failing device is backed off, and names a
+    variable to publish its health state to:
+
+    {
+      "var" : "/HW/ADS7830/HEALTH",
+      "threshold" : "3",
+      "backoff" : "10",
+      "backoff_max" : "1000",
+      "probe" : "5000"
+    }
+
+    After a failed transaction the device is left alone for "backoff"
+    milliseconds, doubling with each consecutive failure up to
+    "backoff_max".  After "threshold" consecutive failures the circuit
+    breaker opens, and the device is only probed every "probe"
+    milliseconds until it responds.  The defaults apply when the
+    object is absent.
+
+    @param[in]
+        pBuilder
+            pointer to the configuration builder
+
+    @param[in]
+        pNode
+            pointer to the health node (may be NULL)
+
+==============================================================================*/
+static void ParseHealth( ConfigBuilder *pBuilder, JNode *pNode )
+{
+    uint32_t var;
+    char *attr;
+
+    pBuilder->pConfig->healthThreshold = CONFIG_HEALTH_THRESHOLD;
+    pBuilder->pConfig->healthBackoff = CONFIG_HEALTH_BACKOFF;
+    pBuilder->pConfig->healthBackoffMax = CONFIG_HEALTH_BACKOFF_MAX;
+    pBuilder->pConfig->healthProbe = CONFIG_HEALTH_PROBE;
+
+    if ( pNode != NULL )
+    {
+        /* add the string first since it may move the config */
+        var = AddString( pBuilder, JSON_GetStr( pNode, "var" ) );
+        pBuilder->pConfig->healthVar = var;
+
+        attr = JSON_GetStr( pNode, "threshold" );
+        if ( attr != NULL )
+        {
+            pBuilder->pConfig->healthThreshold = strtoul( attr, NULL, 0 );
+        }
+
+        attr = JSON_GetStr( pNode, "backoff" );
+        if ( attr != NULL )
+        {
+            pBuilder->pConfig->healthBackoff = strtoul( attr, NULL, 0 );
+        }
+
+        attr = JSON_GetStr( pNode, "backoff_max" );
+        if ( attr != NULL )
+        {
+            pBuilder->pConfig->healthBackoffMax = strtoul( attr, NULL, 0 );
+        }
+
+        attr = JSON_GetStr( pNode, "probe" );
+        if ( attr != NULL )
+        {
+            pBuilder->pConfig->healthProbe = strtoul( attr, NULL, 0 );
+        }
+    }
+}
+
+/*============================================================================*/
+/*  ParseReplay                                                               */
+/*!
+    Parse the replay settings
+
+    The ParseReplay function parses the optional replay object, which
+    names the recording played back by the replay backend:
+
+    {
+      "file" : "/tmp/ads7830.flight",
+      "speed" : "1"
+    }
+
+    The recording is played at "speed" times its original pace (1 by
+    default).  A speed of 0 plays every recorded sample through the
+    channels as fast as possible when the configuration is applied.
+
+    @param[in]
+        pBuilder
+            pointer to the configuration builder
+
+    @param[in]
+        pNode
+            pointer to the replay node (may be NULL)
+
+==============================================================================*/
+static void ParseReplay( ConfigBuilder *pBuilder, JNode *pNode )
+{
+    uint32_t file;
+
+    pBuilder->pConfig->replaySpeed = 1.0f;
+
+    if ( pNode != NULL )
+    {
+        /* add the string first since it may move the config */
+        file = AddString( pBuilder, JSON_GetStr( pNode, "file" ) );
+        pBuilder->pConfig->replayFile = file;
+
+        pBuilder->pConfig->replaySpeed = GetDouble( pNode, "speed", 1.0 );
+        if ( pBuilder->pConfig->replaySpeed < 0.0f )
+        {
+            fprintf( stderr, "invalid replay speed\n" );
+            pBuilder->pConfig->replaySpeed = 1.0f;
+        }
+    }
+}
+
+/*============================================================================*/
+/*  AddString                                                                 */
+/*!
+    Add a string to the configuration string table
+
+    The AddString function appends a string to the string table of the
+    configuration being compiled, growing the configuration as required.
+    Growing the configuration may move it, so pointers into it must
+    be refreshed after calling this function.
+
+    @param[in]
+        pBuilder
+            pointer to the configuration builder
+
+    @param[in]
+        str
+            pointer to the string to add
+
+    @retval string table offset of the added string
+    @retval 0 if the string is NULL or could not be added
+
+==============================================================================*/
+static uint32_t AddString( ConfigBuilder *pBuilder, char *str )
+{
+    uint32_t offset = 0;
+
+    if ( str != NULL )
+    {
+        offset = AddData( pBuilder, str, strlen( str ) + 1, 1 );
+    }
+
+    return offset;
+}
+
+/*============================================================================*/
+/*  AddData                                                                   */
+/*!
+    Add a block of data to the configuration string table
+
+    The AddData function appends a block of data to the string table
+    of the configuration being compiled, aligned relative to the start
+    of the configuration, and growing the configuration as required.
+    Growing the configuration may move it, so pointers into it must
+    be refreshed after calling this function.
+
+    @param[in]
+        pBuilder
+            pointer to the configuration builder
+
+    @param[in]
+        pData
+            pointer to the data to add
+
+    @param[in]
+        len
+            length of the data in bytes
+
+    @param[in]
+        align
+            required alignment of the data (power of 2)
+
+    @retval string table offset of the added data
+    @retval 0 if the data could not be added
+
+==============================================================================*/
+static uint32_t AddData( ConfigBuilder *pBuilder,
+                         const void *pData,
+                         size_t len,
+                         size_t align )
+{
+    uint32_t offset = 0;
+    size_t pad;
+    size_t required;
+    size_t capacity;
+    Config *pConfig;
+
+    if ( ( pBuilder != NULL ) &&
+         ( pBuilder->pConfig != NULL ) &&
+         ( pData != NULL ) &&
+         ( align != 0 ) )
+    {
+        pad = ( align - ( ( offsetof( Config, strtab )
+                            + pBuilder->pConfig->strtabSize )
+                          & ( align - 1 ) ) ) & ( align - 1 );
+        required = offsetof( Config, strtab )
+                   + pBuilder->pConfig->strtabSize
+                   + pad
+                   + len;
+
+        if ( required > pBuilder->capacity )
+        {
+            capacity = pBuilder->capacity * 2;
+            while ( capacity < required )
+            {
+                capacity *= 2;
+            }
+
+            pConfig = realloc( pBuilder->pConfig, capacity );
+            if ( pConfig != NULL )
+            {
+                pBuilder->pConfig = pConfig;
+                pBuilder->capacity = capacity;
+            }
+            else
+            {
+                pBuilder->result = ENOMEM;
+            }
+        }
+
+        if ( required <= pBuilder->capacity )
+        {
+            pConfig = pBuilder->pConfig;
+            memset( &pConfig->strtab[pConfig->strtabSize], 0, pad );
+            offset = pConfig->strtabSize + pad;
+            memcpy( &pConfig->strtab[offset], pData, len );
+            pConfig->strtabSize = offset + len;
+        }
+    }
+
+    return offset;
+}
+
+/*============================================================================*/
+/*  Checksum                                                                  */
+/*!
+    Calculate the checksum of a compiled configuration
+
+    The Checksum function calculates a 32-bit FNV-1a hash over the
+    compiled configuration following the header.
+
+    @param[in]
+        pConfig
+            pointer to the compiled configuration
+
+    @retval the configuration checksum
+
+==============================================================================*/
+static uint32_t Checksum( Config *pConfig )
+{
+    uint32_t hash = 2166136261U;
+    uint8_t *p;
+    size_t i;
+    size_t n;
+
+    p = (uint8_t *)pConfig + offsetof( Config, device );
+    n = pConfig->size - offsetof( Config, device );
+
+    for ( i = 0; i < n; i++ )
+    {
+        hash ^= p[i];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+/*! @}
+ * end of config group */
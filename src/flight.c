@@ -0,0 +1,216 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup flight flight
+ * @brief Acquisition flight recorder for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file flight.c
+
+    Acquisition Flight Recorder
+
+    The flight recorder is always on.  It keeps the most recent
+    FLIGHT_RECORDER_SIZE acquisition events (timestamp, channel,
+    value, result code and latency) in a statically allocated ring
+    so a stale channel can be diagnosed after the fact without
+    running in verbose mode.
+
+    The ring has a single writer.  Entries are written in place and
+    the head index is published with a release store, so recording
+    an event never takes a lock or allocates memory.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include "flight.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*! flight recorder index mask */
+#define FLIGHT_RECORDER_MASK ( FLIGHT_RECORDER_SIZE - 1 )
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _flight_event structure stores a single acquisition event */
+typedef struct _flight_event
+{
+    /*! monotonic timestamp in microseconds */
+    uint64_t ts;
+
+    /*! acquisition latency in microseconds */
+    uint32_t latency;
+
+    /*! channel number */
+    int16_t channel;
+
+    /*! sampled value */
+    int16_t value;
+
+    /*! acquisition result code */
+    int32_t result;
+} FlightEvent;
+
+/*==============================================================================
+        Private file scoped variables
+==============================================================================*/
+
+/*! flight recorder ring buffer */
+static FlightEvent flightBuffer[FLIGHT_RECORDER_SIZE];
+
+/*! total number of events ever recorded */
+static atomic_uint_fast64_t flightHead;
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  FLIGHT_Record                                                             */
+/*!
+    Record an acquisition event
+
+    The FLIGHT_Record function stores an acquisition event in the
+    flight recorder, overwriting the oldest event.
+
+    @param[in]
+        ts
+            monotonic timestamp of the event in microseconds
+
+    @param[in]
+        channel
+            the channel which was sampled
+
+    @param[in]
+        value
+            the sampled value
+
+    @param[in]
+        result
+            the acquisition result code
+
+    @param[in]
+        latency
+            the acquisition latency in microseconds
+
+==============================================================================*/
+void FLIGHT_Record( uint64_t ts,
+                    int channel,
+                    int value,
+                    int result,
+                    uint32_t latency )
+{
+    uint_fast64_t head;
+    FlightEvent *pEvent;
+
+    head = atomic_load_explicit( &flightHead, memory_order_relaxed );
+    pEvent = &flightBuffer[head & FLIGHT_RECORDER_MASK];
+
+    pEvent->ts = ts;
+    pEvent->latency = latency;
+    pEvent->channel = channel;
+    pEvent->value = value;
+    pEvent->result = result;
+
+    atomic_store_explicit( &flightHead, head + 1, memory_order_release );
+}
+
+/*============================================================================*/
+/*  FLIGHT_Dump                                                               */
+/*!
+    Dump the flight recorder
+
+    The FLIGHT_Dump function writes the content of the flight recorder
+    to the specified file descriptor, oldest event first.
+
+    @param[in]
+        fd
+            output file descriptor
+
+    @retval EOK the flight recorder was dumped
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+int FLIGHT_Dump( int fd )
+{
+    int result = EINVAL;
+    uint_fast64_t head;
+    uint_fast64_t i;
+    uint_fast64_t count;
+    FlightEvent *pEvent;
+
+    if ( fd != -1 )
+    {
+        head = atomic_load_explicit( &flightHead, memory_order_acquire );
+        count = ( head < FLIGHT_RECORDER_SIZE ) ? head : FLIGHT_RECORDER_SIZE;
+
+        dprintf( fd,
+                 "ADS7830 Flight Recorder: %llu of %llu events\n",
+                 (unsigned long long)count,
+                 (unsigned long long)head );
+
+        dprintf( fd, "       timestamp  ch value latency result\n" );
+
+        for ( i = head - count; i < head; i++ )
+        {
+            pEvent = &flightBuffer[i & FLIGHT_RECORDER_MASK];
+
+            dprintf( fd,
+                     "%9llu.%06llu  A%d   %03d %4u us %s\n",
+                     (unsigned long long)( pEvent->ts / 1000000 ),
+                     (unsigned long long)( pEvent->ts % 1000000 ),
+                     pEvent->channel,
+                     pEvent->value,
+                     pEvent->latency,
+                     ( pEvent->result == EOK ) ? "ok"
+                                               : strerror( pEvent->result ) );
+        }
+
+        result = EOK;
+    }
+
+    return result;
+}
+
+/*! @}
+ * end of flight group */
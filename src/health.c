@@ -0,0 +1,239 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup health health
+ * @brief Device health tracking for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file health.c
+
+    Device Health
+
+    The device health tracker isolates a faulty or missing device so
+    that failing transactions do not stall the event loop.  After a
+    failure, transactions are refused for a backoff period which
+    doubles with each consecutive failure.  Once the number of
+    consecutive failures reaches the threshold, the circuit breaker
+    opens and the device is only probed at the probe interval until
+    a transaction succeeds.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stddef.h>
+#include "health.h"
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  HEALTH_Init                                                               */
+/*!
+    Initialize a device health tracker
+
+    The HEALTH_Init function initializes a device health tracker
+    in the healthy state.
+
+    @param[in]
+        pHealth
+            pointer to the health tracker to initialize
+
+    @param[in]
+        threshold
+            consecutive failures which open the circuit breaker (at least 1)
+
+    @param[in]
+        backoffMin
+            initial backoff after a failure in microseconds
+
+    @param[in]
+        backoffMax
+            maximum backoff in microseconds
+
+    @param[in]
+        probeInterval
+            interval between probes while the breaker is open,
+            in microseconds
+
+==============================================================================*/
+void HEALTH_Init( Health *pHealth,
+                  uint32_t threshold,
+                  uint64_t backoffMin,
+                  uint64_t backoffMax,
+                  uint64_t probeInterval )
+{
+    if ( pHealth != NULL )
+    {
+        pHealth->threshold = ( threshold > 0 ) ? threshold : 1;
+        pHealth->backoffMin = backoffMin;
+        pHealth->backoffMax = ( backoffMax > backoffMin )
+                              ? backoffMax
+                              : backoffMin;
+        pHealth->probeInterval = probeInterval;
+
+        pHealth->state = HEALTH_OK;
+        pHealth->failures = 0;
+        pHealth->backoff = pHealth->backoffMin;
+        pHealth->retryAt = 0;
+        pHealth->errors = 0;
+        pHealth->trips = 0;
+        pHealth->probes = 0;
+        pHealth->recoveries = 0;
+    }
+}
+
+/*============================================================================*/
+/*  HEALTH_Allow                                                              */
+/*!
+    Check if a transaction may be attempted
+
+    The HEALTH_Allow function checks if the device is out of its
+    backoff period.  A transaction allowed while the circuit breaker
+    is open is a probe, and the next probe is scheduled.
+
+    @param[in]
+        pHealth
+            pointer to the health tracker
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+    @retval true the transaction may be attempted
+    @retval false the device is backed off
+
+==============================================================================*/
+bool HEALTH_Allow( Health *pHealth, uint64_t now )
+{
+    bool result = true;
+
+    if ( ( pHealth != NULL ) &&
+         ( pHealth->state != HEALTH_OK ) )
+    {
+        if ( now < pHealth->retryAt )
+        {
+            result = false;
+        }
+        else if ( pHealth->state == HEALTH_FAILED )
+        {
+            pHealth->probes++;
+            pHealth->retryAt = now + pHealth->probeInterval;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  HEALTH_Report                                                             */
+/*!
+    Report the outcome of a transaction
+
+    The HEALTH_Report function updates the device health with the
+    outcome of an attempted transaction.  A success closes the circuit
+    breaker and resets the backoff.  A failure extends the backoff, and
+    opens the circuit breaker once the failure threshold is reached.
+
+    @param[in]
+        pHealth
+            pointer to the health tracker
+
+    @param[in]
+        success
+            true if the transaction succeeded
+
+    @param[in]
+        now
+            timestamp of the transaction in microseconds
+
+    @retval true the health state changed
+    @retval false the health state did not change
+
+==============================================================================*/
+bool HEALTH_Report( Health *pHealth, bool success, uint64_t now )
+{
+    bool result = false;
+    HealthState state;
+
+    if ( pHealth != NULL )
+    {
+        if ( success == true )
+        {
+            if ( pHealth->state == HEALTH_FAILED )
+            {
+                pHealth->recoveries++;
+            }
+
+            state = HEALTH_OK;
+            pHealth->failures = 0;
+            pHealth->backoff = pHealth->backoffMin;
+            pHealth->retryAt = 0;
+        }
+        else
+        {
+            pHealth->errors++;
+            pHealth->failures++;
+
+            if ( pHealth->failures >= pHealth->threshold )
+            {
+                /* open the circuit breaker and wait for a probe */
+                if ( pHealth->state != HEALTH_FAILED )
+                {
+                    pHealth->trips++;
+                }
+
+                state = HEALTH_FAILED;
+                pHealth->retryAt = now + pHealth->probeInterval;
+            }
+            else
+            {
+                /* back off exponentially */
+                state = HEALTH_DEGRADED;
+                pHealth->retryAt = now + pHealth->backoff;
+                pHealth->backoff *= 2;
+                if ( pHealth->backoff > pHealth->backoffMax )
+                {
+                    pHealth->backoff = pHealth->backoffMax;
+                }
+            }
+        }
+
+        result = ( state != pHealth->state );
+        pHealth->state = state;
+    }
+
+    return result;
+}
+
+/*! @}
+ * end of health group */
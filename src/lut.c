@@ -0,0 +1,222 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup lut lut
+ * @brief Conversion tables for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file lut.c
+
+    Conversion Tables
+
+    The ADS7830 is an 8-bit converter, so any transfer function from
+    counts to engineering units can be fully precomputed into a
+    LUT_SIZE entry table when the configuration is loaded.  Converting
+    a sample is then a single table index, no matter how expensive
+    the transfer function is.
+
+    Tables can be built by linear interpolation between a list of
+    breakpoints, or from the Steinhart-Hart (or beta) equation of an
+    NTC thermistor in a resistor divider.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <errno.h>
+#include <math.h>
+#include "lut.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*! 0 degrees Celsius in Kelvin */
+#define LUT_KELVIN 273.15
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  LUT_Breakpoints                                                           */
+/*!
+    Build a conversion table from breakpoints
+
+    The LUT_Breakpoints function builds a conversion table by linear
+    interpolation between breakpoints.  Counts below the first or
+    above the last breakpoint are clamped to the first or last value.
+
+    @param[in]
+        pPoints
+            pointer to an array of breakpoints in increasing counts order
+
+    @param[in]
+        n
+            number of breakpoints
+
+    @param[in,out]
+        pTable
+            pointer to the LUT_SIZE entry table to populate
+
+    @retval EOK the table was built
+    @retval EINVAL invalid arguments or breakpoints out of order
+
+==============================================================================*/
+int LUT_Breakpoints( LUTPoint *pPoints, size_t n, float *pTable )
+{
+    int result = EINVAL;
+    size_t i;
+    size_t seg = 0;
+    float x;
+    float t;
+
+    if ( ( pPoints != NULL ) &&
+         ( pTable != NULL ) &&
+         ( n > 0 ) )
+    {
+        result = EOK;
+
+        for ( i = 1; i < n; i++ )
+        {
+            if ( pPoints[i].counts <= pPoints[i-1].counts )
+            {
+                result = EINVAL;
+            }
+        }
+
+        for ( i = 0; ( result == EOK ) && ( i < LUT_SIZE ); i++ )
+        {
+            x = (float)i;
+
+            /* find the segment containing x */
+            while ( ( seg + 1 < n ) && ( pPoints[seg + 1].counts < x ) )
+            {
+                seg++;
+            }
+
+            if ( ( x <= pPoints[0].counts ) || ( n == 1 ) )
+            {
+                pTable[i] = pPoints[0].value;
+            }
+            else if ( x >= pPoints[n - 1].counts )
+            {
+                pTable[i] = pPoints[n - 1].value;
+            }
+            else
+            {
+                t = ( x - pPoints[seg].counts )
+                    / ( pPoints[seg + 1].counts - pPoints[seg].counts );
+                pTable[i] = pPoints[seg].value
+                            + t * ( pPoints[seg + 1].value
+                                    - pPoints[seg].value );
+            }
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  LUT_Thermistor                                                            */
+/*!
+    Build a thermistor conversion table
+
+    The LUT_Thermistor function builds a conversion table from ADC counts
+    to temperature in degrees Celsius for an NTC thermistor connected
+    between the ADC input and ground, with a series resistor between the
+    ADC input and the ADC reference.  The Steinhart-Hart equation is
+    used unless a beta coefficient is specified.
+
+    The end points of the table (where the thermistor resistance would
+    be zero or infinite) are clamped to their neighbours.
+
+    @param[in]
+        pThermistor
+            pointer to the thermistor definition
+
+    @param[in,out]
+        pTable
+            pointer to the LUT_SIZE entry table to populate
+
+    @retval EOK the table was built
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+int LUT_Thermistor( LUTThermistor *pThermistor, float *pTable )
+{
+    int result = EINVAL;
+    int i;
+    double r;
+    double lnr;
+    double invT;
+
+    if ( ( pThermistor != NULL ) &&
+         ( pTable != NULL ) &&
+         ( pThermistor->rseries > 0.0 ) &&
+         ( ( pThermistor->beta == 0.0 ) || ( pThermistor->r0 > 0.0 ) ) )
+    {
+        result = EOK;
+
+        for ( i = 1; i < LUT_SIZE - 1; i++ )
+        {
+            /* thermistor resistance from the divider ratio */
+            r = pThermistor->rseries * i / (double)( ( LUT_SIZE - 1 ) - i );
+            lnr = log( r );
+
+            if ( pThermistor->beta != 0.0 )
+            {
+                invT = ( 1.0 / ( pThermistor->t0 + LUT_KELVIN ) )
+                       + ( log( r / pThermistor->r0 ) / pThermistor->beta );
+            }
+            else
+            {
+                invT = pThermistor->a
+                       + ( pThermistor->b * lnr )
+                       + ( pThermistor->c * lnr * lnr * lnr );
+            }
+
+            pTable[i] = (float)( ( 1.0 / invT ) - LUT_KELVIN );
+        }
+
+        pTable[0] = pTable[1];
+        pTable[LUT_SIZE - 1] = pTable[LUT_SIZE - 2];
+    }
+
+    return result;
+}
+
+/*! @}
+ * end of lut group */
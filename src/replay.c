@@ -0,0 +1,600 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup replay replay
+ * @brief Recorded sample playback for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file replay.c
+
+    Sample Replay
+
+    The replay module plays back a recorded sample stream in place of
+    the ADC, so field incidents can be reproduced and the conversion,
+    alarm, statistics and publishing stages can be exercised without
+    hardware.  Two recording formats are accepted, and can be mixed:
+
+    - a flight recorder dump, as written on SIGUSR1, where only the
+      successful samples are played:
+
+          2484.732317  A1   031   58 us ok
+
+    - CSV lines in the packed scan format: a timestamp in microseconds
+      followed by the counts of channels A0 to A7, where empty fields
+      are channels which were not sampled:
+
+          8412207718,103,0,,,,,,
+
+    Playback is either paced, where each sample is due when the
+    scheduler clock, scaled by the playback speed, reaches its recorded
+    timestamp, or unpaced, where the caller steps through the samples
+    as fast as it can.  In both cases the caller plays each sample with
+    REPLAY_Next, so no recorded sample is skipped.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "replay.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*! initial number of samples allocated for a recording */
+#define REPLAY_INITIAL_SIZE 1024
+
+/*==============================================================================
+        Private function declarations
+==============================================================================*/
+
+static int ParseLine( Replay *pReplay, char *line );
+static int ParseFlight( Replay *pReplay, char *line );
+static int ParseCSV( Replay *pReplay, char *line );
+static int Append( Replay *pReplay, uint64_t time, int channel, long value );
+static void Play( Replay *pReplay );
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  REPLAY_Load                                                               */
+/*!
+    Load a recorded sample stream
+
+    The REPLAY_Load function reads a flight recorder dump or CSV file
+    of recorded samples into memory.  Lines which are not samples, such
+    as headers and failed samples, are skipped.
+
+    @param[in]
+        pReplay
+            pointer to the replay to load
+
+    @param[in]
+        pFileName
+            name of the recording file
+
+    @retval EOK the recording was loaded
+    @retval EINVAL invalid arguments
+    @retval ENODATA the recording contains no samples
+    @retval ENOMEM memory allocation failed
+    @retval other error from fopen
+
+==============================================================================*/
+int REPLAY_Load( Replay *pReplay, const char *pFileName )
+{
+    int result = EINVAL;
+    FILE *fp;
+    char *line = NULL;
+    size_t len = 0;
+
+    if ( ( pReplay != NULL ) &&
+         ( pFileName != NULL ) )
+    {
+        memset( pReplay, 0, sizeof( Replay ) );
+
+        fp = fopen( pFileName, "r" );
+        if ( fp != NULL )
+        {
+            result = EOK;
+            while ( ( result == EOK ) &&
+                    ( getline( &line, &len, fp ) != -1 ) )
+            {
+                result = ParseLine( pReplay, line );
+            }
+
+            free( line );
+            fclose( fp );
+
+            if ( ( result == EOK ) && ( pReplay->count == 0 ) )
+            {
+                result = ENODATA;
+            }
+
+            if ( result != EOK )
+            {
+                REPLAY_Release( pReplay );
+            }
+        }
+        else
+        {
+            result = errno;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  REPLAY_Release                                                            */
+/*!
+    Release a recorded sample stream
+
+    The REPLAY_Release function frees a loaded recording.
+
+    @param[in]
+        pReplay
+            pointer to the replay to release
+
+==============================================================================*/
+void REPLAY_Release( Replay *pReplay )
+{
+    if ( pReplay != NULL )
+    {
+        free( pReplay->pSamples );
+        memset( pReplay, 0, sizeof( Replay ) );
+    }
+}
+
+/*============================================================================*/
+/*  REPLAY_Start                                                              */
+/*!
+    Start playback of a recording
+
+    The REPLAY_Start function rewinds a recording and starts playing
+    it.  With paced playback, the first recorded sample is due at the
+    start time, and later samples fall due as the recording time
+    catches up with them (see REPLAY_Due).
+
+    @param[in]
+        pReplay
+            pointer to the replay
+
+    @param[in]
+        speed
+            playback speed relative to the recording, or 0 to step
+            through the samples with REPLAY_Next
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+==============================================================================*/
+void REPLAY_Start( Replay *pReplay, float speed, uint64_t now )
+{
+    if ( pReplay != NULL )
+    {
+        pReplay->next = 0;
+        pReplay->origin = ( pReplay->count > 0 )
+                          ? pReplay->pSamples[0].time
+                          : 0;
+        pReplay->start = now;
+        pReplay->speed = ( speed > 0.0f ) ? speed : 0.0f;
+        memset( pReplay->valid, 0, sizeof( pReplay->valid ) );
+    }
+}
+
+/*============================================================================*/
+/*  REPLAY_Next                                                               */
+/*!
+    Play the next recorded sample
+
+    The REPLAY_Next function plays the next recorded sample regardless
+    of its timestamp.  With paced playback it is called when the
+    sample falls due.
+
+    @param[in]
+        pReplay
+            pointer to the replay
+
+    @param[out]
+        pChannel
+            pointer to a location to store the channel of the sample
+
+    @retval EOK the sample was played
+    @retval EINVAL invalid arguments
+    @retval ENODATA the end of the recording was reached
+
+==============================================================================*/
+int REPLAY_Next( Replay *pReplay, int *pChannel )
+{
+    int result = EINVAL;
+
+    if ( ( pReplay != NULL ) &&
+         ( pChannel != NULL ) )
+    {
+        if ( pReplay->next < pReplay->count )
+        {
+            *pChannel = pReplay->pSamples[pReplay->next].channel;
+            Play( pReplay );
+            result = EOK;
+        }
+        else
+        {
+            result = ENODATA;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  REPLAY_Due                                                                */
+/*!
+    Get the time the next recorded sample is due
+
+    The REPLAY_Due function gets the time at which the next recorded
+    sample is due to be played with paced playback: the start time
+    plus the recorded time since the first sample, divided by the
+    playback speed.
+
+    @param[in]
+        pReplay
+            pointer to the replay
+
+    @retval time the next sample is due in microseconds
+    @retval 0 playback is unpaced or the recording has ended
+
+==============================================================================*/
+uint64_t REPLAY_Due( Replay *pReplay )
+{
+    uint64_t due = 0;
+    uint64_t offset = 0;
+    uint64_t time;
+
+    if ( ( pReplay != NULL ) &&
+         ( pReplay->speed > 0.0f ) &&
+         ( pReplay->next < pReplay->count ) )
+    {
+        /* a sample recorded out of order is due immediately */
+        time = pReplay->pSamples[pReplay->next].time;
+        if ( time > pReplay->origin )
+        {
+            offset = time - pReplay->origin;
+        }
+
+        due = pReplay->start
+              + (uint64_t)( offset / (double)pReplay->speed );
+
+        /* 0 means nothing is due */
+        if ( due == 0 )
+        {
+            due = 1;
+        }
+    }
+
+    return due;
+}
+
+/*============================================================================*/
+/*  REPLAY_Read                                                               */
+/*!
+    Read a channel from the recording
+
+    The REPLAY_Read function gets the most recently played value of
+    a channel.  The value is held between samples and after the end
+    of the recording.
+
+    @param[in]
+        pReplay
+            pointer to the replay
+
+    @param[in]
+        channel
+            the id of the channel to read
+
+    @param[out]
+        data
+            pointer to a location to store the channel value
+
+    @retval EOK the channel was read
+    @retval EINVAL invalid arguments
+    @retval ENODATA the channel has not been recorded yet
+
+==============================================================================*/
+int REPLAY_Read( Replay *pReplay, int channel, uint8_t *data )
+{
+    int result = EINVAL;
+
+    if ( ( pReplay != NULL ) &&
+         ( channel >= 0 ) &&
+         ( channel < REPLAY_MAX_CHANNELS ) &&
+         ( data != NULL ) )
+    {
+        if ( pReplay->valid[channel] == true )
+        {
+            *data = pReplay->value[channel];
+            result = EOK;
+        }
+        else
+        {
+            result = ENODATA;
+        }
+    }
+
+    return result;
+}
+
+/*==============================================================================
+        Private function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  ParseLine                                                                 */
+/*!
+    Parse a line of a recording
+
+    The ParseLine function parses a line of a recording as CSV if it
+    contains a comma, and as a flight recorder dump line otherwise.
+
+    @param[in]
+        pReplay
+            pointer to the replay being loaded
+
+    @param[in]
+        line
+            the line to parse
+
+    @retval EOK the line was parsed or skipped
+    @retval ENOMEM memory allocation failed
+
+==============================================================================*/
+static int ParseLine( Replay *pReplay, char *line )
+{
+    return ( strchr( line, ',' ) != NULL )
+           ? ParseCSV( pReplay, line )
+           : ParseFlight( pReplay, line );
+}
+
+/*============================================================================*/
+/*  ParseFlight                                                               */
+/*!
+    Parse a flight recorder dump line
+
+    The ParseFlight function parses a line of a flight recorder dump,
+    and adds it to the recording if it is a successful sample.
+
+    @param[in]
+        pReplay
+            pointer to the replay being loaded
+
+    @param[in]
+        line
+            the line to parse
+
+    @retval EOK the line was parsed or skipped
+    @retval ENOMEM memory allocation failed
+
+==============================================================================*/
+static int ParseFlight( Replay *pReplay, char *line )
+{
+    int result = EOK;
+    unsigned long long sec;
+    unsigned long long usec;
+    int channel;
+    unsigned int value;
+    char status[16];
+
+    if ( ( sscanf( line,
+                   "%llu.%6llu A%d %u %*u us %15s",
+                   &sec,
+                   &usec,
+                   &channel,
+                   &value,
+                   status ) == 5 ) &&
+         ( strcmp( status, "ok" ) == 0 ) )
+    {
+        result = Append( pReplay, ( sec * 1000000 ) + usec, channel, value );
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  ParseCSV                                                                  */
+/*!
+    Parse a CSV line
+
+    The ParseCSV function parses a line of packed scan CSV, and adds
+    a sample to the recording for each non-empty channel field.
+
+    @param[in]
+        pReplay
+            pointer to the replay being loaded
+
+    @param[in]
+        line
+            the line to parse
+
+    @retval EOK the line was parsed or skipped
+    @retval ENOMEM memory allocation failed
+
+==============================================================================*/
+static int ParseCSV( Replay *pReplay, char *line )
+{
+    int result = EOK;
+    uint64_t time;
+    char *p;
+    char *end;
+    long value;
+    int channel = 0;
+
+    time = strtoull( line, &p, 10 );
+    if ( p != line )
+    {
+        while ( ( result == EOK ) &&
+                ( *p == ',' ) &&
+                ( channel < REPLAY_MAX_CHANNELS ) )
+        {
+            p++;
+
+            value = strtol( p, &end, 10 );
+            if ( end != p )
+            {
+                result = Append( pReplay, time, channel, value );
+                p = end;
+            }
+
+            /* skip any trailing characters of the field */
+            while ( ( *p != ',' ) && ( *p != '\0' ) )
+            {
+                p++;
+            }
+
+            channel++;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  Append                                                                    */
+/*!
+    Append a sample to a recording
+
+    The Append function adds a sample to the recording being loaded,
+    growing the sample array as required.  Samples of unknown channels
+    are skipped, and values are limited to the 8 bit range.
+
+    @param[in]
+        pReplay
+            pointer to the replay being loaded
+
+    @param[in]
+        time
+            timestamp of the sample in microseconds
+
+    @param[in]
+        channel
+            channel of the sample
+
+    @param[in]
+        value
+            sampled value in counts
+
+    @retval EOK the sample was appended or skipped
+    @retval ENOMEM memory allocation failed
+
+==============================================================================*/
+static int Append( Replay *pReplay, uint64_t time, int channel, long value )
+{
+    int result = EOK;
+    ReplaySample *pSamples;
+    size_t size;
+
+    if ( ( channel >= 0 ) && ( channel < REPLAY_MAX_CHANNELS ) )
+    {
+        /* grow the sample array when the count reaches a power of 2 */
+        if ( ( pReplay->count >= REPLAY_INITIAL_SIZE ) &&
+             ( ( pReplay->count & ( pReplay->count - 1 ) ) == 0 ) )
+        {
+            size = pReplay->count * 2;
+        }
+        else if ( pReplay->count == 0 )
+        {
+            size = REPLAY_INITIAL_SIZE;
+        }
+        else
+        {
+            size = 0;
+        }
+
+        if ( size != 0 )
+        {
+            pSamples = realloc( pReplay->pSamples,
+                                size * sizeof( ReplaySample ) );
+            if ( pSamples != NULL )
+            {
+                pReplay->pSamples = pSamples;
+            }
+            else
+            {
+                result = ENOMEM;
+            }
+        }
+
+        if ( result == EOK )
+        {
+            pSamples = &pReplay->pSamples[pReplay->count++];
+            pSamples->time = time;
+            pSamples->channel = channel;
+            pSamples->value = ( value < 0 ) ? 0
+                              : ( value > 255 ) ? 255
+                              : value;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  Play                                                                      */
+/*!
+    Play the next sample of a recording
+
+    The Play function makes the next sample of the recording the
+    current value of its channel.
+
+    @param[in]
+        pReplay
+            pointer to the replay
+
+==============================================================================*/
+static void Play( Replay *pReplay )
+{
+    ReplaySample *pSample = &pReplay->pSamples[pReplay->next++];
+
+    pReplay->value[pSample->channel] = pSample->value;
+    pReplay->valid[pSample->channel] = true;
+}
+
+/*! @}
+ * end of replay group */
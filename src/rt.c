@@ -0,0 +1,314 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup rt rt
+ * @brief Real-time execution profile for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file rt.c
+
+    Real-Time Execution Profile
+
+    The real-time profile reduces sampling jitter by running the
+    calling thread under the SCHED_FIFO policy, pinning it to a set
+    of CPUs, and locking the process memory so the sampling path does
+    not take page faults.  The scheduling policy and CPU affinity are
+    applied to the calling thread only, so each thread can be given
+    its own profile.  Each setting is attempted independently and its
+    result is recorded so the daemon can report what was applied.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#define _GNU_SOURCE
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include "rt.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*! size of a memory page assumed when prefaulting the stack */
+#define RT_PAGE_SIZE 4096
+
+/*==============================================================================
+        Private function declarations
+==============================================================================*/
+
+static int SetScheduler( int priority );
+static int LockMemory( void );
+static void PrefaultStack( void );
+static int SetAffinity( uint64_t mask );
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  RT_Apply                                                                  */
+/*!
+    Apply a real-time execution profile
+
+    The RT_Apply function applies each requested setting of the
+    real-time profile to the calling thread and records the result of
+    each one in the profile.  A failure to apply one setting does not
+    prevent the others from being applied.
+
+    @param[in,out]
+        pProfile
+            pointer to the real-time profile to apply
+
+    @retval EOK all requested settings were applied
+    @retval EINVAL invalid arguments
+    @retval other the error from the first setting which failed
+
+==============================================================================*/
+int RT_Apply( RTProfile *pProfile )
+{
+    int result = EINVAL;
+
+    if ( pProfile != NULL )
+    {
+        pProfile->lockResult = RT_NOT_REQUESTED;
+        pProfile->affinityResult = RT_NOT_REQUESTED;
+        pProfile->schedResult = RT_NOT_REQUESTED;
+        result = EOK;
+
+        /* lock memory first so the stack prefault is retained */
+        if ( pProfile->lock == true )
+        {
+            pProfile->lockResult = LockMemory();
+            result = pProfile->lockResult;
+        }
+
+        if ( pProfile->affinity != 0 )
+        {
+            pProfile->affinityResult = SetAffinity( pProfile->affinity );
+            if ( result == EOK )
+            {
+                result = pProfile->affinityResult;
+            }
+        }
+
+        if ( pProfile->priority != 0 )
+        {
+            pProfile->schedResult = SetScheduler( pProfile->priority );
+            if ( result == EOK )
+            {
+                result = pProfile->schedResult;
+            }
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  RT_Result                                                                 */
+/*!
+    Describe the result of a real-time setting
+
+    The RT_Result function gets a description of the result of
+    applying a real-time setting, suitable for a status report.
+
+    @param[in]
+        result
+            the result recorded by RT_Apply
+
+    @retval pointer to the result description
+
+==============================================================================*/
+const char *RT_Result( int result )
+{
+    const char *pResult;
+
+    if ( result == RT_NOT_REQUESTED )
+    {
+        pResult = "not requested";
+    }
+    else if ( result == EOK )
+    {
+        pResult = "applied";
+    }
+    else
+    {
+        pResult = strerror( result );
+    }
+
+    return pResult;
+}
+
+/*==============================================================================
+        Private function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  SetScheduler                                                              */
+/*!
+    Run the calling thread under the SCHED_FIFO policy
+
+    The SetScheduler function sets the scheduling policy of the calling
+    thread to SCHED_FIFO at the specified priority.
+
+    @param[in]
+        priority
+            SCHED_FIFO priority
+
+    @retval EOK the scheduling policy was set
+    @retval EINVAL the priority is out of range
+    @retval EPERM the process is not permitted to use SCHED_FIFO
+
+==============================================================================*/
+static int SetScheduler( int priority )
+{
+    int result = EINVAL;
+    struct sched_param param;
+
+    if ( ( priority >= sched_get_priority_min( SCHED_FIFO ) ) &&
+         ( priority <= sched_get_priority_max( SCHED_FIFO ) ) )
+    {
+        memset( &param, 0, sizeof( param ) );
+        param.sched_priority = priority;
+
+        /* a pid of 0 selects the calling thread */
+        result = ( sched_setscheduler( 0, SCHED_FIFO, &param ) == 0 )
+                 ? EOK
+                 : errno;
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  LockMemory                                                                */
+/*!
+    Lock the process memory
+
+    The LockMemory function locks all current and future pages of the
+    process into memory, stops the heap from returning memory to the
+    system so that reallocated arenas stay resident, and prefaults the
+    calling thread's stack.
+
+    @retval EOK the memory was locked
+    @retval ENOMEM the locked memory limit was exceeded
+    @retval EPERM the process is not permitted to lock memory
+
+==============================================================================*/
+static int LockMemory( void )
+{
+    int result;
+
+    if ( mlockall( MCL_CURRENT | MCL_FUTURE ) == 0 )
+    {
+        /* keep freed heap memory locked for reuse */
+        (void)mallopt( M_TRIM_THRESHOLD, -1 );
+        (void)mallopt( M_MMAP_MAX, 0 );
+
+        PrefaultStack();
+        result = EOK;
+    }
+    else
+    {
+        result = errno;
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  PrefaultStack                                                             */
+/*!
+    Prefault the stack of the calling thread
+
+    The PrefaultStack function touches every page of a stack region
+    so that, once memory is locked, the stack is already resident and
+    does not take a page fault the first time it grows.
+
+==============================================================================*/
+static void __attribute__(( noinline )) PrefaultStack( void )
+{
+    volatile unsigned char stack[RT_PREFAULT_STACK];
+    size_t i;
+
+    for ( i = 0; i < sizeof( stack ); i += RT_PAGE_SIZE )
+    {
+        stack[i] = 0;
+    }
+}
+
+/*============================================================================*/
+/*  SetAffinity                                                               */
+/*!
+    Pin the calling thread to a set of CPUs
+
+    The SetAffinity function restricts the calling thread to the CPUs
+    selected by the bits of the affinity mask.
+
+    @param[in]
+        mask
+            CPU affinity mask where bit n selects CPU n
+
+    @retval EOK the CPU affinity was set
+    @retval EINVAL the mask does not select any available CPU
+
+==============================================================================*/
+static int SetAffinity( uint64_t mask )
+{
+    cpu_set_t cpus;
+    int cpu;
+
+    CPU_ZERO( &cpus );
+    for ( cpu = 0; cpu < 64; cpu++ )
+    {
+        if ( mask & ( 1ULL << cpu ) )
+        {
+            CPU_SET( cpu, &cpus );
+        }
+    }
+
+    /* a pid of 0 selects the calling thread */
+    return ( sched_setaffinity( 0, sizeof( cpus ), &cpus ) == 0 )
+           ? EOK
+           : errno;
+}
+
+/*! @}
+ * end of rt group */
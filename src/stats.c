@@ -0,0 +1,542 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup stats stats
+ * @brief Rolling window statistics for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file stats.c
+
+    Rolling Window Statistics
+
+    The rolling window statistics maintain the minimum, maximum, mean
+    and standard deviation of the samples of a channel taken within a
+    sliding time window.
+
+    The samples are held in a ring buffer.  The minimum and maximum
+    are tracked with monotonic deques (each new sample removes the
+    samples it dominates from the back of the deque, and expired
+    samples are removed from the front), and the mean and variance
+    are tracked with running sums, so each sample is added in O(1)
+    amortized time.  The running sums are recalculated from the ring
+    buffer once per ring buffer cycle to stop rounding errors
+    accumulating.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include "stats.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*! maximum window ring buffer capacity in samples */
+#define STATS_MAX_CAPACITY 65536
+
+/*==============================================================================
+        Private function declarations
+==============================================================================*/
+
+static void Expire( WindowStats *pStats, uint64_t now );
+static void Evict( WindowStats *pStats );
+static void Recalculate( WindowStats *pStats );
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  STATS_Capacity                                                            */
+/*!
+    Calculate the capacity of a statistics window
+
+    The STATS_Capacity function rounds the requested number of samples
+    up to the power of 2 capacity of the window ring buffer.
+
+    @param[in]
+        samples
+            maximum number of samples expected in the window
+
+    @retval ring buffer capacity in samples
+
+==============================================================================*/
+uint32_t STATS_Capacity( uint32_t samples )
+{
+    uint32_t capacity = 1;
+
+    while ( ( capacity < samples ) &&
+            ( capacity < STATS_MAX_CAPACITY ) )
+    {
+        capacity <<= 1;
+    }
+
+    return capacity;
+}
+
+/*============================================================================*/
+/*  STATS_ArenaSize                                                           */
+/*!
+    Calculate the arena size required by a statistics window
+
+    The STATS_ArenaSize function calculates the arena space required
+    for the buffers of a statistics window.
+
+    @param[in]
+        samples
+            maximum number of samples expected in the window
+
+    @retval arena size in bytes
+
+==============================================================================*/
+size_t STATS_ArenaSize( uint32_t samples )
+{
+    size_t capacity = STATS_Capacity( samples );
+
+    return ARENA_Reserve( capacity * sizeof( float ), sizeof( float ) )
+           + ARENA_Reserve( capacity * sizeof( uint64_t ), sizeof( uint64_t ) )
+           + ( 2 * ARENA_Reserve( capacity * sizeof( uint32_t ),
+                                  sizeof( uint32_t ) ) );
+}
+
+/*============================================================================*/
+/*  STATS_Init                                                                */
+/*!
+    Initialize a statistics window
+
+    The STATS_Init function allocates the buffers of a statistics
+    window from an arena and clears the window.
+
+    @param[in,out]
+        pStats
+            pointer to the statistics window to initialize
+
+    @param[in]
+        pArena
+            pointer to the arena to allocate the buffers from
+
+    @param[in]
+        samples
+            maximum number of samples expected in the window
+
+    @param[in]
+        window
+            window length in microseconds
+
+    @retval EOK the statistics window was initialized
+    @retval ENOMEM the buffers could not be allocated
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+int STATS_Init( WindowStats *pStats,
+                Arena *pArena,
+                uint32_t samples,
+                uint64_t window )
+{
+    int result = EINVAL;
+    uint32_t capacity;
+
+    if ( ( pStats != NULL ) &&
+         ( pArena != NULL ) &&
+         ( samples > 0 ) )
+    {
+        capacity = STATS_Capacity( samples );
+
+        pStats->pValue = ARENA_Alloc( pArena,
+                                      capacity * sizeof( float ),
+                                      sizeof( float ) );
+        pStats->pTime = ARENA_Alloc( pArena,
+                                     capacity * sizeof( uint64_t ),
+                                     sizeof( uint64_t ) );
+        pStats->pMinQ = ARENA_Alloc( pArena,
+                                     capacity * sizeof( uint32_t ),
+                                     sizeof( uint32_t ) );
+        pStats->pMaxQ = ARENA_Alloc( pArena,
+                                     capacity * sizeof( uint32_t ),
+                                     sizeof( uint32_t ) );
+
+        if ( ( pStats->pValue != NULL ) &&
+             ( pStats->pTime != NULL ) &&
+             ( pStats->pMinQ != NULL ) &&
+             ( pStats->pMaxQ != NULL ) )
+        {
+            pStats->capacity = capacity;
+            pStats->window = window;
+            pStats->seq = 0;
+            pStats->count = 0;
+            pStats->minHead = 0;
+            pStats->minCount = 0;
+            pStats->maxHead = 0;
+            pStats->maxCount = 0;
+            pStats->sum = 0.0;
+            pStats->sumSq = 0.0;
+            pStats->sinceRecalc = 0;
+            result = EOK;
+        }
+        else
+        {
+            pStats->capacity = 0;
+            result = ENOMEM;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  STATS_Copy                                                                */
+/*!
+    Copy the contents of a statistics window
+
+    The STATS_Copy function copies the samples, deques and running sums
+    of a statistics window into another window of the same capacity,
+    so the window can be carried into a new arena without losing its
+    history.
+
+    @param[in,out]
+        pDst
+            pointer to the initialized statistics window to copy into
+
+    @param[in]
+        pSrc
+            pointer to the statistics window to copy from
+
+    @retval EOK the statistics window was copied
+    @retval EINVAL invalid arguments or the capacities differ
+
+==============================================================================*/
+int STATS_Copy( WindowStats *pDst, const WindowStats *pSrc )
+{
+    int result = EINVAL;
+    uint32_t capacity;
+
+    if ( ( pDst != NULL ) &&
+         ( pSrc != NULL ) &&
+         ( pDst->capacity != 0 ) &&
+         ( pDst->capacity == pSrc->capacity ) )
+    {
+        capacity = pSrc->capacity;
+
+        memcpy( pDst->pValue, pSrc->pValue, capacity * sizeof( float ) );
+        memcpy( pDst->pTime, pSrc->pTime, capacity * sizeof( uint64_t ) );
+        memcpy( pDst->pMinQ, pSrc->pMinQ, capacity * sizeof( uint32_t ) );
+        memcpy( pDst->pMaxQ, pSrc->pMaxQ, capacity * sizeof( uint32_t ) );
+
+        pDst->window = pSrc->window;
+        pDst->seq = pSrc->seq;
+        pDst->count = pSrc->count;
+        pDst->minHead = pSrc->minHead;
+        pDst->minCount = pSrc->minCount;
+        pDst->maxHead = pSrc->maxHead;
+        pDst->maxCount = pSrc->maxCount;
+        pDst->sum = pSrc->sum;
+        pDst->sumSq = pSrc->sumSq;
+        pDst->sinceRecalc = pSrc->sinceRecalc;
+
+        result = EOK;
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  STATS_Add                                                                 */
+/*!
+    Add a sample to a statistics window
+
+    The STATS_Add function adds a sample to a statistics window,
+    expiring the samples which have left the window.  If the ring
+    buffer is full the oldest sample is evicted, even if it is still
+    within the window.
+
+    @param[in,out]
+        pStats
+            pointer to the statistics window
+
+    @param[in]
+        value
+            sample value
+
+    @param[in]
+        now
+            timestamp of the sample in microseconds
+
+==============================================================================*/
+void STATS_Add( WindowStats *pStats, float value, uint64_t now )
+{
+    uint32_t mask;
+    uint32_t pos;
+    uint32_t back;
+
+    if ( ( pStats != NULL ) &&
+         ( pStats->capacity != 0 ) )
+    {
+        mask = pStats->capacity - 1;
+
+        Expire( pStats, now );
+        if ( pStats->count == pStats->capacity )
+        {
+            Evict( pStats );
+        }
+
+        /* add the sample to the ring buffer */
+        pos = pStats->seq & mask;
+        pStats->pValue[pos] = value;
+        pStats->pTime[pos] = now;
+
+        /* drop the samples which can no longer be the minimum */
+        while ( pStats->minCount > 0 )
+        {
+            back = pStats->pMinQ[( pStats->minHead + pStats->minCount - 1 )
+                                 & mask];
+            if ( pStats->pValue[back & mask] < value )
+            {
+                break;
+            }
+
+            pStats->minCount--;
+        }
+
+        pStats->pMinQ[( pStats->minHead + pStats->minCount ) & mask] =
+            pStats->seq;
+        pStats->minCount++;
+
+        /* drop the samples which can no longer be the maximum */
+        while ( pStats->maxCount > 0 )
+        {
+            back = pStats->pMaxQ[( pStats->maxHead + pStats->maxCount - 1 )
+                                 & mask];
+            if ( pStats->pValue[back & mask] > value )
+            {
+                break;
+            }
+
+            pStats->maxCount--;
+        }
+
+        pStats->pMaxQ[( pStats->maxHead + pStats->maxCount ) & mask] =
+            pStats->seq;
+        pStats->maxCount++;
+
+        pStats->sum += value;
+        pStats->sumSq += (double)value * value;
+        pStats->count++;
+        pStats->seq++;
+
+        if ( ++pStats->sinceRecalc >= pStats->capacity )
+        {
+            Recalculate( pStats );
+        }
+    }
+}
+
+/*============================================================================*/
+/*  STATS_Get                                                                 */
+/*!
+    Get the statistics of a window
+
+    The STATS_Get function expires the samples which have left the
+    window, and gets the statistics of the remaining samples.
+
+    @param[in,out]
+        pStats
+            pointer to the statistics window
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+    @param[in,out]
+        pResult
+            pointer to the statistics result to populate
+
+    @retval EOK the statistics were calculated
+    @retval ENODATA there are no samples in the window
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+int STATS_Get( WindowStats *pStats, uint64_t now, StatsResult *pResult )
+{
+    int result = EINVAL;
+    uint32_t mask;
+    double mean;
+    double variance;
+
+    if ( ( pStats != NULL ) &&
+         ( pStats->capacity != 0 ) &&
+         ( pResult != NULL ) )
+    {
+        mask = pStats->capacity - 1;
+
+        Expire( pStats, now );
+
+        pResult->count = pStats->count;
+        if ( pStats->count > 0 )
+        {
+            mean = pStats->sum / pStats->count;
+            variance = ( pStats->sumSq / pStats->count ) - ( mean * mean );
+
+            pResult->min = pStats->pValue[pStats->pMinQ[pStats->minHead]
+                                          & mask];
+            pResult->max = pStats->pValue[pStats->pMaxQ[pStats->maxHead]
+                                          & mask];
+            pResult->mean = mean;
+            pResult->stddev = ( variance > 0.0 ) ? sqrt( variance ) : 0.0f;
+            result = EOK;
+        }
+        else
+        {
+            result = ENODATA;
+        }
+    }
+
+    return result;
+}
+
+/*==============================================================================
+        Private function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  Expire                                                                    */
+/*!
+    Expire the samples which have left a statistics window
+
+    The Expire function evicts the samples which are older than the
+    window length.
+
+    @param[in,out]
+        pStats
+            pointer to the statistics window
+
+    @param[in]
+        now
+            current timestamp in microseconds
+
+==============================================================================*/
+static void Expire( WindowStats *pStats, uint64_t now )
+{
+    uint32_t oldest;
+
+    while ( pStats->count > 0 )
+    {
+        oldest = ( pStats->seq - pStats->count ) & ( pStats->capacity - 1 );
+        if ( pStats->pTime[oldest] + pStats->window > now )
+        {
+            break;
+        }
+
+        Evict( pStats );
+    }
+}
+
+/*============================================================================*/
+/*  Evict                                                                     */
+/*!
+    Evict the oldest sample from a statistics window
+
+    The Evict function removes the oldest sample from a statistics
+    window, its running sums, and the front of the minimum and
+    maximum deques.
+
+    @param[in,out]
+        pStats
+            pointer to the statistics window
+
+==============================================================================*/
+static void Evict( WindowStats *pStats )
+{
+    uint32_t mask = pStats->capacity - 1;
+    uint32_t oldest = pStats->seq - pStats->count;
+    float value = pStats->pValue[oldest & mask];
+
+    pStats->sum -= value;
+    pStats->sumSq -= (double)value * value;
+    pStats->count--;
+
+    if ( ( pStats->minCount > 0 ) &&
+         ( pStats->pMinQ[pStats->minHead] == oldest ) )
+    {
+        pStats->minHead = ( pStats->minHead + 1 ) & mask;
+        pStats->minCount--;
+    }
+
+    if ( ( pStats->maxCount > 0 ) &&
+         ( pStats->pMaxQ[pStats->maxHead] == oldest ) )
+    {
+        pStats->maxHead = ( pStats->maxHead + 1 ) & mask;
+        pStats->maxCount--;
+    }
+}
+
+/*============================================================================*/
+/*  Recalculate                                                               */
+/*!
+    Recalculate the running sums of a statistics window
+
+    The Recalculate function recalculates the running sums of a
+    statistics window from the samples in its ring buffer, discarding
+    any accumulated rounding error.
+
+    @param[in,out]
+        pStats
+            pointer to the statistics window
+
+==============================================================================*/
+static void Recalculate( WindowStats *pStats )
+{
+    uint32_t mask = pStats->capacity - 1;
+    uint32_t seq;
+    float value;
+
+    pStats->sum = 0.0;
+    pStats->sumSq = 0.0;
+
+    for ( seq = pStats->seq - pStats->count; seq != pStats->seq; seq++ )
+    {
+        value = pStats->pValue[seq & mask];
+        pStats->sum += value;
+        pStats->sumSq += (double)value * value;
+    }
+
+    pStats->sinceRecalc = 0;
+}
+
+/*! @}
+ * end of stats group */
@@ -0,0 +1,176 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup sysfs sysfs
+ * @brief sysfs attribute access for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file sysfs.c
+
+    sysfs Attributes
+
+    The sysfs module reads integer attributes of a kernel driver, such
+    as the hwmon or IIO channel inputs of an ADC bound to an in-kernel
+    driver.  Attribute files are opened once and kept open, and each
+    read uses pread at offset zero, which makes the kernel regenerate
+    the attribute value without reopening the file.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "sysfs.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*! maximum length of a sysfs attribute path */
+#define SYSFS_PATH_LEN 256
+
+/*! maximum length of a sysfs attribute value */
+#define SYSFS_VALUE_LEN 32
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  SYSFS_Open                                                                */
+/*!
+    Open a sysfs attribute
+
+    The SYSFS_Open function opens a sysfs attribute file for reading.
+
+    @param[in]
+        dir
+            path of the sysfs device directory
+
+    @param[in]
+        attr
+            name of the attribute within the directory
+
+    @param[out]
+        pfd
+            pointer to a location to store the attribute file descriptor
+
+    @retval EOK the attribute was opened
+    @retval EINVAL invalid arguments
+    @retval ENAMETOOLONG the attribute path is too long
+    @retval other error from open
+
+==============================================================================*/
+int SYSFS_Open( const char *dir, const char *attr, int *pfd )
+{
+    int result = EINVAL;
+    char path[SYSFS_PATH_LEN];
+    int n;
+
+    if ( ( dir != NULL ) &&
+         ( attr != NULL ) &&
+         ( pfd != NULL ) )
+    {
+        *pfd = -1;
+
+        n = snprintf( path, sizeof( path ), "%s/%s", dir, attr );
+        if ( ( n > 0 ) && ( (size_t)n < sizeof( path ) ) )
+        {
+            *pfd = open( path, O_RDONLY | O_CLOEXEC );
+            result = ( *pfd != -1 ) ? EOK : errno;
+        }
+        else
+        {
+            result = ENAMETOOLONG;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  SYSFS_Read                                                                */
+/*!
+    Read an integer sysfs attribute
+
+    The SYSFS_Read function reads the current value of an open integer
+    sysfs attribute.
+
+    @param[in]
+        fd
+            attribute file descriptor
+
+    @param[out]
+        pValue
+            pointer to a location to store the attribute value
+
+    @retval EOK the attribute was read
+    @retval EINVAL invalid arguments
+    @retval EIO the attribute is not an integer
+    @retval other error from pread
+
+==============================================================================*/
+int SYSFS_Read( int fd, long *pValue )
+{
+    int result = EINVAL;
+    char buf[SYSFS_VALUE_LEN];
+    char *end;
+    ssize_t n;
+
+    if ( ( fd != -1 ) &&
+         ( pValue != NULL ) )
+    {
+        n = pread( fd, buf, sizeof( buf ) - 1, 0 );
+        if ( n > 0 )
+        {
+            buf[n] = '\0';
+            *pValue = strtol( buf, &end, 10 );
+            result = ( end != buf ) ? EOK : EIO;
+        }
+        else
+        {
+            result = ( n == 0 ) ? EIO : errno;
+        }
+    }
+
+    return result;
+}
+
+/*! @}
+ * end of sysfs group */
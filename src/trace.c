@@ -0,0 +1,299 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup trace trace
+ * @brief Timeline trace buffer for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file trace.c
+
+    Timeline Trace Buffer
+
+    The trace module maintains a bounded in-memory ring of timestamped
+    events from the event loop and the I2C bus layer.  When the ring
+    is full the oldest events are overwritten.
+
+    The buffer can be dumped in the Chrome trace-event JSON format
+    which can be loaded directly into chrome://tracing or
+    https://ui.perfetto.dev to visualize how timers, CALC requests
+    and bus transactions interleave.
+
+    Event loop activity is rendered on thread lane 1, bus transactions
+    on thread lane 2 and variable server updates on thread lane 3.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include "timestamp.h"
+#include "trace.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*==============================================================================
+        Type definitions
+==============================================================================*/
+
+/*! the _trace_event structure stores a single completed trace span */
+typedef struct _trace_event
+{
+    /*! start timestamp in microseconds */
+    uint64_t ts;
+
+    /*! duration in microseconds */
+    uint32_t dur;
+
+    /*! event identifier */
+    uint16_t id;
+
+    /*! event argument (usually the channel number) */
+    int16_t arg;
+} TraceEvent;
+
+/*! the _trace_info structure describes how an event is rendered */
+typedef struct _trace_info
+{
+    /*! event name */
+    const char *name;
+
+    /*! event category */
+    const char *cat;
+
+    /*! thread lane */
+    int tid;
+} TraceInfo;
+
+/*==============================================================================
+        Private file scoped variables
+==============================================================================*/
+
+/*! trace event ring buffer */
+static TraceEvent *pTraceBuffer = NULL;
+
+/*! number of entries in the ring buffer */
+static size_t traceSize = 0;
+
+/*! index of the next entry to write */
+static size_t traceHead = 0;
+
+/*! number of valid entries in the ring buffer */
+static size_t traceCount = 0;
+
+/*! rendering information for each event identifier */
+static const TraceInfo traceInfo[TRACE_EVENT_MAX] =
+{
+    { "timer", "loop", 1 },
+    { "calc", "loop", 1 },
+    { "print", "loop", 1 },
+    { "i2c", "bus", 2 },
+    { "var_set", "varserver", 3 },
+    { "scan", "loop", 1 }
+};
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  TRACE_Init                                                                */
+/*!
+    Initialize the trace buffer
+
+    The TRACE_Init function allocates the trace ring buffer.  Tracing
+    remains disabled if the size is zero.
+
+    @param[in]
+        size
+            maximum number of events held in the trace buffer
+
+    @retval EOK the trace buffer was initialized
+    @retval ENOMEM memory allocation failed
+
+==============================================================================*/
+int TRACE_Init( size_t size )
+{
+    int result = EOK;
+
+    if ( size > 0 )
+    {
+        pTraceBuffer = calloc( size, sizeof( TraceEvent ) );
+        if ( pTraceBuffer != NULL )
+        {
+            traceSize = size;
+            traceHead = 0;
+            traceCount = 0;
+        }
+        else
+        {
+            result = ENOMEM;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  TRACE_Begin                                                               */
+/*!
+    Start a trace span
+
+    The TRACE_Begin function gets the start timestamp of a trace span.
+
+    @retval start timestamp in microseconds
+    @retval 0 if tracing is disabled
+
+==============================================================================*/
+uint64_t TRACE_Begin( void )
+{
+    return ( pTraceBuffer != NULL ) ? TIMESTAMP_Now() : 0;
+}
+
+/*============================================================================*/
+/*  TRACE_End                                                                 */
+/*!
+    Complete a trace span
+
+    The TRACE_End function records a completed trace span in the
+    trace buffer, overwriting the oldest event if the buffer is full.
+
+    @param[in]
+        id
+            trace event identifier
+
+    @param[in]
+        arg
+            event argument
+
+    @param[in]
+        start
+            start timestamp returned from TRACE_Begin
+
+==============================================================================*/
+void TRACE_End( TraceEventID id, int arg, uint64_t start )
+{
+    TraceEvent *pEvent;
+
+    if ( ( pTraceBuffer != NULL ) &&
+         ( start != 0 ) &&
+         ( id < TRACE_EVENT_MAX ) )
+    {
+        pEvent = &pTraceBuffer[traceHead];
+        pEvent->ts = start;
+        pEvent->dur = (uint32_t)( TIMESTAMP_Now() - start );
+        pEvent->id = id;
+        pEvent->arg = arg;
+
+        traceHead = ( traceHead + 1 ) % traceSize;
+        if ( traceCount < traceSize )
+        {
+            traceCount++;
+        }
+    }
+}
+
+/*============================================================================*/
+/*  TRACE_Dump                                                                */
+/*!
+    Dump the trace buffer
+
+    The TRACE_Dump function writes the content of the trace buffer
+    to the specified file descriptor as a Chrome trace-event JSON
+    object, oldest event first.
+
+    @param[in]
+        fd
+            output file descriptor
+
+    @retval EOK the trace buffer was dumped
+    @retval ENOTSUP tracing is not enabled
+    @retval EINVAL invalid arguments
+
+==============================================================================*/
+int TRACE_Dump( int fd )
+{
+    int result = EINVAL;
+    size_t i;
+    size_t idx;
+    TraceEvent *pEvent;
+    const TraceInfo *pInfo;
+
+    if ( fd != -1 )
+    {
+        if ( pTraceBuffer != NULL )
+        {
+            dprintf( fd, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" );
+
+            idx = ( traceHead + traceSize - traceCount ) % traceSize;
+            for ( i = 0; i < traceCount; i++ )
+            {
+                pEvent = &pTraceBuffer[idx];
+                pInfo = &traceInfo[pEvent->id];
+
+                dprintf( fd,
+                         "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+                         "\"ts\":%llu,\"dur\":%u,\"pid\":1,\"tid\":%d,"
+                         "\"args\":{\"channel\":%d}}",
+                         ( i == 0 ) ? "" : ",",
+                         pInfo->name,
+                         pInfo->cat,
+                         (unsigned long long)pEvent->ts,
+                         pEvent->dur,
+                         pInfo->tid,
+                         pEvent->arg );
+
+                idx = ( idx + 1 ) % traceSize;
+            }
+
+            dprintf( fd, "\n]}\n" );
+
+            result = EOK;
+        }
+        else
+        {
+            dprintf( fd, "tracing is not enabled\n" );
+            result = ENOTSUP;
+        }
+    }
+
+    return result;
+}
+
+/*! @}
+ * end of trace group */
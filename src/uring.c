@@ -0,0 +1,577 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup uring uring
+ * @brief io_uring bus transfers for the ADS7830 server
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file uring.c
+
+    io_uring Bus Transfers
+
+    The uring module submits a batch of ADS7830 conversions to the
+    kernel with a single io_uring_enter system call, instead of a write
+    and a read system call for each channel.  Each conversion is a
+    write of the channel command byte followed by a read of the result,
+    and the whole batch is linked so it executes in order on the bus.
+    The i2c-dev driver does not support non-blocking I/O, so the kernel
+    runs the transfers on its io_uring worker threads.
+
+    The io_uring system calls are used directly, so the module has no
+    library dependencies.  If the kernel headers do not provide
+    io_uring, the module reports ENOTSUP.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include "uring.h"
+
+#ifdef HAVE_LINUX_IO_URING_H
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+/*==============================================================================
+        Private function declarations
+==============================================================================*/
+
+#ifdef HAVE_LINUX_IO_URING_H
+static int MapRing( URing *pRing, struct io_uring_params *pParams );
+static void Prepare( URing *pRing,
+                     int op,
+                     int fd,
+                     uint8_t *buf,
+                     uint64_t userData,
+                     bool link );
+static int Reap( URing *pRing, int *results, int count );
+#endif
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+#ifdef HAVE_LINUX_IO_URING_H
+
+/*============================================================================*/
+/*  URING_Init                                                                */
+/*!
+    Set up an io_uring
+
+    The URING_Init function creates an io_uring with the specified
+    number of submission queue entries and maps its queues.
+
+    @param[in]
+        pRing
+            pointer to the io_uring to set up
+
+    @param[in]
+        entries
+            number of submission queue entries (two per conversion)
+
+    @retval EOK the io_uring was set up
+    @retval EINVAL invalid arguments
+    @retval other error from io_uring_setup or mmap
+
+==============================================================================*/
+int URING_Init( URing *pRing, unsigned entries )
+{
+    int result = EINVAL;
+    struct io_uring_params params;
+
+    if ( ( pRing != NULL ) &&
+         ( entries > 0 ) )
+    {
+        memset( pRing, 0, sizeof( URing ) );
+        memset( &params, 0, sizeof( params ) );
+
+        pRing->fd = syscall( __NR_io_uring_setup, entries, &params );
+        if ( pRing->fd != -1 )
+        {
+            result = MapRing( pRing, &params );
+            if ( result == EOK )
+            {
+                pRing->entries = params.sq_entries;
+            }
+            else
+            {
+                URING_Release( pRing );
+            }
+        }
+        else
+        {
+            result = errno;
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  URING_Release                                                             */
+/*!
+    Release an io_uring
+
+    The URING_Release function unmaps the queues of an io_uring and
+    closes it.
+
+    @param[in]
+        pRing
+            pointer to the io_uring to release
+
+==============================================================================*/
+void URING_Release( URing *pRing )
+{
+    if ( pRing != NULL )
+    {
+        if ( pRing->pSQEs != NULL )
+        {
+            munmap( pRing->pSQEs, pRing->sqesSize );
+        }
+
+        if ( ( pRing->pCQ != NULL ) && ( pRing->pCQ != pRing->pSQ ) )
+        {
+            munmap( pRing->pCQ, pRing->cqSize );
+        }
+
+        if ( pRing->pSQ != NULL )
+        {
+            munmap( pRing->pSQ, pRing->sqSize );
+        }
+
+        if ( pRing->fd > 0 )
+        {
+            close( pRing->fd );
+        }
+
+        memset( pRing, 0, sizeof( URing ) );
+    }
+}
+
+/*============================================================================*/
+/*  URING_Transfer                                                            */
+/*!
+    Perform a batch of conversions
+
+    The URING_Transfer function submits a linked chain of command byte
+    writes and result reads to the bus device, and waits for all of them
+    to complete.  The device must already be addressed with I2C_SLAVE.
+    A failed transfer cancels the rest of the chain, so a device which
+    stops responding is not accessed again within the batch.  If the
+    batch does not complete, the io_uring is recreated so its late
+    completions are not reaped with the next batch.  If it cannot be
+    recreated, its entries are left at 0.
+
+    @param[in]
+        pRing
+            pointer to the io_uring
+
+    @param[in]
+        fd
+            I2C device file descriptor
+
+    @param[in]
+        cmd
+            array of command bytes, one per conversion
+
+    @param[out]
+        data
+            array to store the conversion results
+
+    @param[out]
+        results
+            array to store the result of each conversion:
+            EOK, ECANCELED if it was not attempted, or an error
+
+    @param[in]
+        count
+            number of conversions (at most half the queue entries)
+
+    @retval EOK the batch was submitted and completed
+    @retval EINVAL invalid arguments
+    @retval other error from io_uring_enter
+
+==============================================================================*/
+int URING_Transfer( URing *pRing,
+                    int fd,
+                    const uint8_t *cmd,
+                    uint8_t *data,
+                    int *results,
+                    int count )
+{
+    int result = EINVAL;
+    unsigned submit;
+    unsigned entries;
+    int rc;
+    int i;
+
+    if ( ( pRing != NULL ) &&
+         ( pRing->entries > 0 ) &&
+         ( cmd != NULL ) &&
+         ( data != NULL ) &&
+         ( results != NULL ) &&
+         ( count > 0 ) &&
+         ( (unsigned)count * 2 <= pRing->entries ) )
+    {
+        for ( i = 0; i < count; i++ )
+        {
+            results[i] = ECANCELED;
+
+            Prepare( pRing,
+                     IORING_OP_WRITE,
+                     fd,
+                     (uint8_t *)&cmd[i],
+                     i * 2,
+                     true );
+
+            Prepare( pRing,
+                     IORING_OP_READ,
+                     fd,
+                     &data[i],
+                     ( i * 2 ) + 1,
+                     ( i < count - 1 ) );
+        }
+
+        /* publish the new entries to the kernel */
+        __atomic_store_n( pRing->sqTail,
+                          *pRing->sqTail + ( count * 2 ),
+                          __ATOMIC_RELEASE );
+
+        submit = count * 2;
+        do
+        {
+            rc = syscall( __NR_io_uring_enter,
+                          pRing->fd,
+                          submit,
+                          count * 2,
+                          IORING_ENTER_GETEVENTS,
+                          NULL,
+                          0 );
+        } while ( ( rc == -1 ) && ( errno == EINTR ) );
+
+        result = ( rc == -1 ) ? errno : Reap( pRing, results, count );
+        if ( result == EIO )
+        {
+            /* completions which arrive late would be matched to the
+               next batch, so discard them with the ring */
+            entries = pRing->entries;
+            URING_Release( pRing );
+            (void)URING_Init( pRing, entries );
+        }
+    }
+
+    return result;
+}
+
+#else
+
+int URING_Init( URing *pRing, unsigned entries )
+{
+    (void)pRing;
+    (void)entries;
+
+    return ENOTSUP;
+}
+
+void URING_Release( URing *pRing )
+{
+    (void)pRing;
+}
+
+int URING_Transfer( URing *pRing,
+                    int fd,
+                    const uint8_t *cmd,
+                    uint8_t *data,
+                    int *results,
+                    int count )
+{
+    (void)pRing;
+    (void)fd;
+    (void)cmd;
+    (void)data;
+    (void)results;
+    (void)count;
+
+    return ENOTSUP;
+}
+
+#endif /* HAVE_LINUX_IO_URING_H */
+
+/*==============================================================================
+        Private function definitions
+==============================================================================*/
+
+#ifdef HAVE_LINUX_IO_URING_H
+
+/*============================================================================*/
+/*  MapRing                                                                   */
+/*!
+    Map the io_uring queues
+
+    The MapRing function maps the submission and completion queues of
+    a newly created io_uring, and locates the queue indices within them.
+
+    @param[in]
+        pRing
+            pointer to the io_uring
+
+    @param[in]
+        pParams
+            pointer to the parameters returned by io_uring_setup
+
+    @retval EOK the queues were mapped
+    @retval other error from mmap
+
+==============================================================================*/
+static int MapRing( URing *pRing, struct io_uring_params *pParams )
+{
+    int result = EOK;
+    uint8_t *pSQ;
+    uint8_t *pCQ;
+    void *p;
+
+    pRing->sqSize = pParams->sq_off.array
+                    + ( pParams->sq_entries * sizeof( unsigned ) );
+    pRing->cqSize = pParams->cq_off.cqes
+                    + ( pParams->cq_entries * sizeof( struct io_uring_cqe ) );
+    pRing->sqesSize = pParams->sq_entries * sizeof( struct io_uring_sqe );
+
+    if ( pParams->features & IORING_FEAT_SINGLE_MMAP )
+    {
+        /* both rings share one mapping */
+        if ( pRing->cqSize > pRing->sqSize )
+        {
+            pRing->sqSize = pRing->cqSize;
+        }
+
+        pRing->cqSize = pRing->sqSize;
+    }
+
+    p = mmap( NULL,
+              pRing->sqSize,
+              PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_POPULATE,
+              pRing->fd,
+              IORING_OFF_SQ_RING );
+    pRing->pSQ = ( p != MAP_FAILED ) ? p : NULL;
+
+    if ( pParams->features & IORING_FEAT_SINGLE_MMAP )
+    {
+        pRing->pCQ = pRing->pSQ;
+    }
+    else
+    {
+        p = mmap( NULL,
+                  pRing->cqSize,
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE,
+                  pRing->fd,
+                  IORING_OFF_CQ_RING );
+        pRing->pCQ = ( p != MAP_FAILED ) ? p : NULL;
+    }
+
+    p = mmap( NULL,
+              pRing->sqesSize,
+              PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_POPULATE,
+              pRing->fd,
+              IORING_OFF_SQES );
+    pRing->pSQEs = ( p != MAP_FAILED ) ? p : NULL;
+
+    if ( ( pRing->pSQ != NULL ) &&
+         ( pRing->pCQ != NULL ) &&
+         ( pRing->pSQEs != NULL ) )
+    {
+        pSQ = pRing->pSQ;
+        pCQ = pRing->pCQ;
+        pRing->sqTail = (unsigned *)( pSQ + pParams->sq_off.tail );
+        pRing->sqMask = (unsigned *)( pSQ + pParams->sq_off.ring_mask );
+        pRing->sqArray = (unsigned *)( pSQ + pParams->sq_off.array );
+        pRing->cqHead = (unsigned *)( pCQ + pParams->cq_off.head );
+        pRing->cqTail = (unsigned *)( pCQ + pParams->cq_off.tail );
+        pRing->cqMask = (unsigned *)( pCQ + pParams->cq_off.ring_mask );
+        pRing->pCQEs = pCQ + pParams->cq_off.cqes;
+    }
+    else
+    {
+        result = errno;
+    }
+
+    return result;
+}
+
+/*============================================================================*/
+/*  Prepare                                                                   */
+/*!
+    Prepare a submission queue entry
+
+    The Prepare function fills in the next submission queue entry with
+    a one byte read or write.  The entry is not visible to the kernel
+    until the submission queue tail is advanced.
+
+    @param[in]
+        pRing
+            pointer to the io_uring
+
+    @param[in]
+        op
+            IORING_OP_READ or IORING_OP_WRITE
+
+    @param[in]
+        fd
+            I2C device file descriptor
+
+    @param[in]
+        buf
+            pointer to the byte to read or write
+
+    @param[in]
+        userData
+            identifier returned with the completion
+
+    @param[in]
+        link
+            true to link the next entry to this one
+
+==============================================================================*/
+static void Prepare( URing *pRing,
+                     int op,
+                     int fd,
+                     uint8_t *buf,
+                     uint64_t userData,
+                     bool link )
+{
+    struct io_uring_sqe *pSQE;
+    unsigned tail;
+    unsigned index;
+
+    /* entries are queued beyond the tail which the kernel can see */
+    tail = *pRing->sqTail + (unsigned)userData;
+    index = tail & *pRing->sqMask;
+
+    pSQE = &( (struct io_uring_sqe *)pRing->pSQEs )[index];
+    memset( pSQE, 0, sizeof( struct io_uring_sqe ) );
+    pSQE->opcode = op;
+    pSQE->fd = fd;
+    pSQE->addr = (uint64_t)(uintptr_t)buf;
+    pSQE->len = 1;
+    pSQE->off = (uint64_t)-1;
+    pSQE->user_data = userData;
+    pSQE->flags = link ? IOSQE_IO_LINK : 0;
+
+    pRing->sqArray[index] = index;
+}
+
+/*============================================================================*/
+/*  Reap                                                                      */
+/*!
+    Reap the completions of a batch of conversions
+
+    The Reap function collects the completions of a batch of conversions
+    and records the result of each conversion.
+
+    @param[in]
+        pRing
+            pointer to the io_uring
+
+    @param[out]
+        results
+            array to store the result of each conversion
+
+    @param[in]
+        count
+            number of conversions in the batch
+
+    @retval EOK all the completions were reaped
+    @retval EIO the kernel did not complete the batch
+
+==============================================================================*/
+static int Reap( URing *pRing, int *results, int count )
+{
+    struct io_uring_cqe *pCQE;
+    unsigned head;
+    unsigned tail;
+    int remaining = count * 2;
+    int i;
+
+    head = *pRing->cqHead;
+    tail = __atomic_load_n( pRing->cqTail, __ATOMIC_ACQUIRE );
+
+    while ( ( head != tail ) && ( remaining > 0 ) )
+    {
+        pCQE = &( (struct io_uring_cqe *)pRing->pCQEs )[head & *pRing->cqMask];
+        i = pCQE->user_data / 2;
+
+        if ( pCQE->res < 0 )
+        {
+            /* keep the first error of the conversion */
+            if ( ( results[i] == ECANCELED ) || ( results[i] == EOK ) )
+            {
+                results[i] = -pCQE->res;
+            }
+        }
+        else if ( pCQE->res != 1 )
+        {
+            results[i] = EIO;
+        }
+        else if ( ( pCQE->user_data & 1 ) && ( results[i] == ECANCELED ) )
+        {
+            /* the read completed after a successful write */
+            results[i] = EOK;
+        }
+
+        head++;
+        remaining--;
+    }
+
+    __atomic_store_n( pRing->cqHead, head, __ATOMIC_RELEASE );
+
+    return ( remaining == 0 ) ? EOK : EIO;
+}
+
+#endif /* HAVE_LINUX_IO_URING_H */
+
+/*! @}
+ * end of uring group */
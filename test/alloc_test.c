@@ -0,0 +1,142 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*============================================================================*/
+/*!
+@file alloc_test.c
+
+    Steady State Allocation Test
+
+    The allocation test checks that the steady-state acquisition loop
+    does not allocate heap memory.  It interposes malloc, calloc and
+    realloc, runs a multi-rate schedule with alarms, statistics,
+    adaptive sampling and a packed scan on the simulated clock, and
+    fails if any allocation is made once the schedule has warmed up.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#define main ads7830_main
+#include "../src/ads7830.c"
+#undef main
+
+#include "harness.h"
+#include "fake_varserver.h"
+
+/*==============================================================================
+        Private file scoped variables
+==============================================================================*/
+
+/*! indicates if heap allocations are being counted */
+static bool counting = false;
+
+/*! number of heap allocations made while counting */
+static size_t allocations = 0;
+
+/*==============================================================================
+        Allocation hooks
+==============================================================================*/
+
+extern void *__libc_malloc( size_t size );
+extern void *__libc_calloc( size_t nmemb, size_t size );
+extern void *__libc_realloc( void *ptr, size_t size );
+
+void *malloc( size_t size )
+{
+    if ( counting == true )
+    {
+        allocations++;
+    }
+
+    return __libc_malloc( size );
+}
+
+void *calloc( size_t nmemb, size_t size )
+{
+    if ( counting == true )
+    {
+        allocations++;
+    }
+
+    return __libc_calloc( nmemb, size );
+}
+
+void *realloc( void *ptr, size_t size )
+{
+    if ( counting == true )
+    {
+        allocations++;
+    }
+
+    return __libc_realloc( ptr, size );
+}
+
+/*==============================================================================
+        Test
+==============================================================================*/
+
+int main( int argc, char **argv )
+{
+    static ADS7830 state;
+    size_t sets;
+
+    HARNESS_Start( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"10\" },"
+        "  { \"channel\" : \"1\", \"var\" : \"/HW/ADS7830/A1\", "
+        "    \"interval\" : \"100\", \"units\" : \"mV\", "
+        "    \"decimals\" : \"1\", "
+        "    \"alarm\" : { \"high\" : \"0.2\", \"low\" : \"0.1\" },"
+        "    \"stats\" : { \"window\" : \"1000\", \"interval\" : \"250\" } },"
+        "  { \"channel\" : \"2\", \"var\" : \"/HW/ADS7830/A2\", "
+        "    \"adaptive\" : { \"min\" : \"20\", \"max\" : \"500\", "
+        "                     \"threshold\" : \"2\" } },"
+        "  { \"channel\" : \"3\", \"var\" : \"/HW/ADS7830/A3\", "
+        "    \"interval\" : \"1000\" } ]",
+        "\"scan\" : { \"var\" : \"/HW/ADS7830/SCAN\", "
+        "\"interval\" : \"50\" }," );
+
+    /* warm up: fill the statistics windows and open the inputs */
+    RunSchedule( &state, 2000000ULL );
+    sets = FAKE_SetCount();
+
+    counting = true;
+    RunSchedule( &state, 60000000ULL );
+    counting = false;
+
+    printf( "%zu samples, %zu updates, %zu allocations\n",
+            (size_t)state.scheduled,
+            FAKE_SetCount() - sets,
+            allocations );
+
+    CHECK( FAKE_SetCount() > sets );
+    CHECK( allocations == 0 );
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*!
+ * @defgroup fake_varserver fake_varserver
+ * @brief In-process variable server for the ADS7830 tests
+ * @{
+ */
+
+/*============================================================================*/
+/*!
+@file fake_varserver.c
+
+    Fake Variable Server
+
+    The fake variable server implements the variable server client
+    API in process, so the ADS7830 tests can run without a variable
+    server.  Every variable exists except the channel control
+    variables, and VAR_Set only counts the updates.  The CALC
+    notifications are tracked per variable.  It does not allocate
+    memory after a variable has been looked up.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <string.h>
+#include <errno.h>
+#include <varserver/varserver.h>
+#include "fake_varserver.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+/*! maximum number of variables known to the fake variable server */
+#define FAKE_MAX_VARS 64
+
+/*==============================================================================
+        Private file scoped variables
+==============================================================================*/
+
+/*! names of the variables which have been looked up */
+static char names[FAKE_MAX_VARS][MAX_NAME_LEN];
+
+/*! number of variables which have been looked up */
+static size_t count = 0;
+
+/*! number of VAR_Set calls */
+static size_t sets = 0;
+
+/*! indicates which variables have a CALC notification */
+static bool calc[FAKE_MAX_VARS];
+
+/*==============================================================================
+        Public function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  FAKE_SetCount                                                             */
+/*!
+    Get the number of variable updates
+
+    @retval number of VAR_Set calls made so far
+
+==============================================================================*/
+size_t FAKE_SetCount( void )
+{
+    return sets;
+}
+
+/*============================================================================*/
+/*  FAKE_CalcNotify                                                           */
+/*!
+    Check if a variable has a CALC notification
+
+    @param[in]
+        hVar
+            handle of the variable to check
+
+    @retval true a CALC notification is registered for the variable
+    @retval false no CALC notification is registered
+
+==============================================================================*/
+bool FAKE_CalcNotify( VAR_HANDLE hVar )
+{
+    return ( hVar != VAR_INVALID ) &&
+           ( hVar <= FAKE_MAX_VARS ) &&
+           ( calc[hVar - 1] == true );
+}
+
+/*==============================================================================
+        Variable server client API
+==============================================================================*/
+
+VARSERVER_HANDLE VARSERVER_Open( void )
+{
+    return (VARSERVER_HANDLE)names;
+}
+
+int VARSERVER_Close( VARSERVER_HANDLE hVarServer )
+{
+    return EOK;
+}
+
+VAR_HANDLE VAR_FindByName( VARSERVER_HANDLE hVarServer, char *name )
+{
+    VAR_HANDLE hVar = VAR_INVALID;
+    size_t i;
+
+    if ( ( name != NULL ) &&
+         ( strstr( name, "/INTERVAL" ) == NULL ) &&
+         ( strstr( name, "/ENABLE" ) == NULL ) )
+    {
+        for ( i = 0; ( i < count ) && ( hVar == VAR_INVALID ); i++ )
+        {
+            if ( strcmp( names[i], name ) == 0 )
+            {
+                hVar = (VAR_HANDLE)( i + 1 );
+            }
+        }
+
+        if ( ( hVar == VAR_INVALID ) && ( count < FAKE_MAX_VARS ) )
+        {
+            strncpy( names[count], name, MAX_NAME_LEN - 1 );
+            hVar = (VAR_HANDLE)( ++count );
+        }
+    }
+
+    return hVar;
+}
+
+int VAR_Notify( VARSERVER_HANDLE hVarServer,
+                VAR_HANDLE hVar,
+                NotificationType type )
+{
+    if ( ( type == NOTIFY_CALC ) &&
+         ( hVar != VAR_INVALID ) &&
+         ( hVar <= FAKE_MAX_VARS ) )
+    {
+        calc[hVar - 1] = true;
+    }
+
+    return EOK;
+}
+
+int VAR_NotifyCancel( VARSERVER_HANDLE hVarServer,
+                      VAR_HANDLE hVar,
+                      NotificationType type )
+{
+    if ( ( type == NOTIFY_CALC ) &&
+         ( hVar != VAR_INVALID ) &&
+         ( hVar <= FAKE_MAX_VARS ) )
+    {
+        calc[hVar - 1] = false;
+    }
+
+    return EOK;
+}
+
+int VAR_Set( VARSERVER_HANDLE hVarServer, VAR_HANDLE hVar, VarObject *pVar )
+{
+    sets++;
+    return EOK;
+}
+
+int VAR_Get( VARSERVER_HANDLE hVarServer, VAR_HANDLE hVar, VarObject *pVar )
+{
+    memset( pVar, 0, sizeof( VarObject ) );
+    pVar->type = VARTYPE_UINT16;
+    return EOK;
+}
+
+int VAR_GetType( VARSERVER_HANDLE hVarServer, VAR_HANDLE hVar, VarType *type )
+{
+    *type = VARTYPE_UINT16;
+    return EOK;
+}
+
+int VAR_OpenPrintSession( VARSERVER_HANDLE hVarServer,
+                          int id,
+                          VAR_HANDLE *hVar,
+                          int *fd )
+{
+    return ENOTSUP;
+}
+
+int VAR_ClosePrintSession( VARSERVER_HANDLE hVarServer, int id, int fd )
+{
+    return ENOTSUP;
+}
+
+/*! @}
+ * end of fake_varserver group */
@@ -0,0 +1,248 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+/*============================================================================*/
+/*!
+@file harness.h
+
+    ADS7830 Test Harness
+
+    The test harness starts an ADS7830 server in process against the
+    simulated clock, so the tests can run its schedule with
+    RunSchedule.  It is included by each test after the ADS7830
+    server source, so the tests can reach the server's private state
+    and functions.
+
+    The channel inputs are served by the hwmon backend from a
+    temporary directory of attribute files, or by the replay backend
+    from a recording, so no ADC is required.
+
+*/
+/*============================================================================*/
+
+#ifndef HARNESS_H
+#define HARNESS_H
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+/*! simulated time at which each test starts in microseconds */
+#define HARNESS_START 1000000ULL
+
+/*! report a failed check and fail the test */
+#define CHECK( cond )                                                   \
+    do                                                                  \
+    {                                                                   \
+        if ( !( cond ) )                                                \
+        {                                                               \
+            fprintf( stderr, "%s:%d: check failed: %s\n",               \
+                     __FILE__, __LINE__, #cond );                       \
+            exit( 1 );                                                  \
+        }                                                               \
+    } while ( 0 )
+
+/*==============================================================================
+        Private file scoped variables
+==============================================================================*/
+
+/*! temporary directory holding the configuration and input files */
+static char harnessDir[] = "/tmp/ads7830-test.XXXXXX";
+
+/*! name of the configuration file */
+static char harnessConfig[sizeof( harnessDir ) + 16];
+
+/*==============================================================================
+        Private function definitions
+==============================================================================*/
+
+/*============================================================================*/
+/*  HARNESS_Cleanup                                                           */
+/*!
+    Remove the temporary files created by HARNESS_Start
+
+==============================================================================*/
+static void HARNESS_Cleanup( void )
+{
+    char name[sizeof( harnessDir ) + 16];
+    int ch;
+
+    for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+    {
+        snprintf( name, sizeof( name ), "%s/in%d_input", harnessDir, ch );
+        unlink( name );
+    }
+
+    unlink( harnessConfig );
+    rmdir( harnessDir );
+}
+
+/*============================================================================*/
+/*  HARNESS_Write                                                             */
+/*!
+    Write the configuration file
+
+    @param[in]
+        backend
+            name of the data source backend ("hwmon" or "replay")
+
+    @param[in]
+        channels
+            JSON array of the channel definitions
+
+    @param[in]
+        extra
+            additional top level configuration members (may be empty)
+
+==============================================================================*/
+static void HARNESS_Write( const char *backend,
+                           const char *channels,
+                           const char *extra )
+{
+    FILE *fp;
+
+    fp = fopen( harnessConfig, "w" );
+    CHECK( fp != NULL );
+    fprintf( fp,
+             "{ \"device\" : \"/dev/null\", \"address\" : \"0x4b\", "
+             "\"backend\" : \"%s\", \"sysfs\" : \"%s\", %s "
+             "\"channels\" : %s }\n",
+             backend,
+             harnessDir,
+             extra,
+             channels );
+    fclose( fp );
+}
+
+/*============================================================================*/
+/*  HARNESS_Start                                                             */
+/*!
+    Start an ADS7830 server against the simulated clock
+
+    The HARNESS_Start function creates the hwmon input attributes,
+    writes the configuration file, and applies it to the server state
+    with the simulated clock at HARNESS_START.
+
+    @param[in,out]
+        pADS7830
+            pointer to the ADS7830 state object to start
+
+    @param[in]
+        backend
+            name of the data source backend ("hwmon" or "replay")
+
+    @param[in]
+        channels
+            JSON array of the channel definitions
+
+    @param[in]
+        extra
+            additional top level configuration members (may be empty)
+
+==============================================================================*/
+static void HARNESS_Start( ADS7830 *pADS7830,
+                           const char *backend,
+                           const char *channels,
+                           const char *extra )
+{
+    static ConfigImage config;
+    char name[sizeof( harnessDir ) + 16];
+    FILE *fp;
+    int ch;
+
+    CHECK( mkdtemp( harnessDir ) != NULL );
+    atexit( HARNESS_Cleanup );
+
+    for ( ch = 0; ch < ADS7830_NUM_CHANNELS; ch++ )
+    {
+        /* a spread of input voltages in millivolts */
+        snprintf( name, sizeof( name ), "%s/in%d_input", harnessDir, ch );
+        fp = fopen( name, "w" );
+        CHECK( fp != NULL );
+        fprintf( fp, "%d\n", 400 * ch );
+        fclose( fp );
+    }
+
+    snprintf( harnessConfig,
+              sizeof( harnessConfig ),
+              "%s/config.json",
+              harnessDir );
+    HARNESS_Write( backend, channels, extra );
+
+    InitState( pADS7830 );
+    pADS7830->pFileName = harnessConfig;
+    CLOCK_Simulate( HARNESS_START );
+
+    CHECK( LoadConfig( pADS7830, &config ) == EOK );
+    pADS7830->device = CONFIG_GetStr( config.pConfig,
+                                      config.pConfig->device );
+    pADS7830->address = config.pConfig->address;
+    pADS7830->hVarServer = VARSERVER_Open();
+    CHECK( ApplyConfig( pADS7830, &config ) == EOK );
+}
+
+/*============================================================================*/
+/*  HARNESS_Reload                                                            */
+/*!
+    Reload the server with a changed configuration
+
+    The HARNESS_Reload function rewrites the configuration file and
+    reloads it as the server does on SIGHUP.
+
+    @param[in,out]
+        pADS7830
+            pointer to the ADS7830 state object started by HARNESS_Start
+
+    @param[in]
+        backend
+            name of the data source backend ("hwmon" or "replay")
+
+    @param[in]
+        channels
+            JSON array of the channel definitions
+
+    @param[in]
+        extra
+            additional top level configuration members (may be empty)
+
+==============================================================================*/
+static void HARNESS_Reload( ADS7830 *pADS7830,
+                            const char *backend,
+                            const char *channels,
+                            const char *extra )
+{
+    HARNESS_Write( backend, channels, extra );
+    CHECK( ReloadConfig( pADS7830 ) == EOK );
+}
+
+#endif /* HARNESS_H */
@@ -0,0 +1,405 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+
+/*============================================================================*/
+/*!
+@file reload_test.c
+
+    Configuration Reload Test
+
+    The reload test checks that reloading the configuration keeps the
+    runtime state which the changed settings do not affect, so
+    untouched channels and services carry on without a gap.  The test
+    case is selected by the first argument:
+
+    - stats: the rolling window statistics of a channel are kept
+      across a reload, and restart when the window settings change.
+
+    - scan: the packed scan keeps its deadline across a reload, and
+      is rescheduled when its interval changes.
+
+    - replay: a paced replay carries on across a reload, and restarts
+      from the first recorded sample when its speed changes.
+
+    - budget: the bus transaction budget keeps its level across a
+      reload, and is refilled when its rate changes.
+
+    - calc: the CALC notification of an on-demand channel is cancelled
+      when the channel is reloaded with a sampling interval.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#define main ads7830_main
+#include "../src/ads7830.c"
+#undef main
+
+#include "harness.h"
+#include "fake_varserver.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+/*! channel A0 with rolling window statistics */
+#define RELOAD_STATS_A0                                                 \
+    "{ \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "            \
+    "  \"interval\" : \"10\", "                                         \
+    "  \"stats\" : { \"window\" : \"1000\", \"interval\" : \"250\" } }"
+
+/*==============================================================================
+        Private file scoped variables
+==============================================================================*/
+
+/*! name of the replay recording */
+static char recording[] = "/tmp/ads7830-recording.XXXXXX";
+
+/*==============================================================================
+        Test cases
+==============================================================================*/
+
+/*============================================================================*/
+/*  RemoveRecording                                                           */
+/*!
+    Remove the replay recording
+
+==============================================================================*/
+static void RemoveRecording( void )
+{
+    unlink( recording );
+}
+
+/*============================================================================*/
+/*  TestStats                                                                 */
+/*!
+    Check that the statistics window survives a reload
+
+==============================================================================*/
+static void TestStats( void )
+{
+    static ADS7830 state;
+    AIN *pAIN = &state.channels[0];
+    uint64_t statsNext;
+    uint32_t count;
+
+    HARNESS_Start( &state,
+        "hwmon",
+        "[ " RELOAD_STATS_A0 ","
+        "  { \"channel\" : \"1\", \"var\" : \"/HW/ADS7830/A1\", "
+        "    \"interval\" : \"100\" } ]",
+        "" );
+
+    RunSchedule( &state, 2000000ULL );
+    count = pAIN->stats.count;
+    statsNext = pAIN->statsNext;
+    CHECK( count > 0 );
+
+    /* change another channel */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ " RELOAD_STATS_A0 ","
+        "  { \"channel\" : \"1\", \"var\" : \"/HW/ADS7830/A1\", "
+        "    \"interval\" : \"200\" } ]",
+        "" );
+
+    CHECK( pAIN->stats.count == count );
+    CHECK( pAIN->statsNext == statsNext );
+
+    RunSchedule( &state, 1000000ULL );
+    CHECK( pAIN->stats.count > 0 );
+
+    /* change the statistics window */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"10\", "
+        "    \"stats\" : { \"window\" : \"500\", \"interval\" : \"250\" } } ]",
+        "" );
+
+    CHECK( pAIN->stats.count == 0 );
+    CHECK( pAIN->statsNext == CLOCK_Now() + pAIN->statsInterval );
+}
+
+/*============================================================================*/
+/*  TestScan                                                                  */
+/*!
+    Check that the packed scan keeps its schedule across a reload
+
+==============================================================================*/
+static void TestScan( void )
+{
+    static ADS7830 state;
+    VAR_HANDLE hScan;
+    uint64_t deadline;
+
+    HARNESS_Start( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"10\" } ]",
+        "\"scan\" : { \"var\" : \"/HW/ADS7830/SCAN\", "
+        "\"interval\" : \"50\" }," );
+
+    RunSchedule( &state, 1020000ULL );
+    hScan = state.hScan;
+    deadline = state.hot.scanDeadline;
+    CHECK( hScan != VAR_INVALID );
+    CHECK( deadline > CLOCK_Now() );
+
+    /* change a channel */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"20\" } ]",
+        "\"scan\" : { \"var\" : \"/HW/ADS7830/SCAN\", "
+        "\"interval\" : \"50\" }," );
+
+    CHECK( state.hScan == hScan );
+    CHECK( state.hot.scanDeadline == deadline );
+
+    /* change the scan interval */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"20\" } ]",
+        "\"scan\" : { \"var\" : \"/HW/ADS7830/SCAN\", "
+        "\"interval\" : \"100\" }," );
+
+    CHECK( state.hot.scanDeadline == CLOCK_Now() + 100000ULL );
+}
+
+/*============================================================================*/
+/*  TestReplay                                                                */
+/*!
+    Check that a paced replay is not rewound by an unrelated reload
+
+==============================================================================*/
+static void TestReplay( void )
+{
+    static ADS7830 state;
+    char extra[128];
+    size_t next;
+    FILE *fp;
+    int fd;
+    int i;
+
+    /* a sample of A0 every 10 ms for 10 s */
+    fd = mkstemp( recording );
+    CHECK( fd != -1 );
+    atexit( RemoveRecording );
+
+    fp = fdopen( fd, "w" );
+    CHECK( fp != NULL );
+    for ( i = 0; i < 1000; i++ )
+    {
+        fprintf( fp, "%d,%d,,,,,,,\n", 10000 * i, i % 256 );
+    }
+
+    fclose( fp );
+
+    snprintf( extra,
+              sizeof( extra ),
+              "\"replay\" : { \"file\" : \"%s\", \"speed\" : \"1\" },",
+              recording );
+
+    HARNESS_Start( &state,
+        "replay",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"0\" } ]",
+        extra );
+
+    RunSchedule( &state, 1000000ULL );
+    next = state.replay.next;
+    CHECK( next > 0 );
+
+    /* change a channel */
+    HARNESS_Reload( &state,
+        "replay",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"100\" } ]",
+        extra );
+
+    CHECK( state.replay.next == next );
+
+    RunSchedule( &state, 1000000ULL );
+    CHECK( state.replay.next > next );
+
+    /* change the playback speed */
+    snprintf( extra,
+              sizeof( extra ),
+              "\"replay\" : { \"file\" : \"%s\", \"speed\" : \"2\" },",
+              recording );
+
+    HARNESS_Reload( &state,
+        "replay",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"100\" } ]",
+        extra );
+
+    CHECK( state.replay.next == 0 );
+}
+
+/*============================================================================*/
+/*  TestBudget                                                                */
+/*!
+    Check that a reload does not refill the bus transaction budget
+
+==============================================================================*/
+static void TestBudget( void )
+{
+    static ADS7830 state;
+    TokenBucket budget;
+
+    /* A0 asks for ten times the budget */
+    HARNESS_Start( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"10\" } ]",
+        "\"budget\" : { \"rate\" : \"10\", \"burst\" : \"8\" }," );
+
+    RunSchedule( &state, 1000000ULL );
+    budget = state.budget;
+    CHECK( state.budgetDropped > 0 );
+    CHECK( budget.level < budget.capacity );
+
+    /* change a channel */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"20\" } ]",
+        "\"budget\" : { \"rate\" : \"10\", \"burst\" : \"8\" }," );
+
+    CHECK( state.budget.level == budget.level );
+    CHECK( state.budget.last == budget.last );
+
+    /* change the budget rate */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"20\" } ]",
+        "\"budget\" : { \"rate\" : \"20\", \"burst\" : \"8\" }," );
+
+    CHECK( state.budget.rate == 20 );
+    CHECK( state.budget.level == state.budget.capacity );
+}
+
+/*============================================================================*/
+/*  TestCalc                                                                  */
+/*!
+    Check that a periodic channel is not also sampled on demand
+
+==============================================================================*/
+static void TestCalc( void )
+{
+    static ADS7830 state;
+    VAR_HANDLE hVar;
+
+    HARNESS_Start( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"0\" } ]",
+        "" );
+
+    hVar = state.channels[0].hVar;
+    CHECK( FAKE_CalcNotify( hVar ) == true );
+
+    /* on demand to periodic */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"100\" } ]",
+        "" );
+
+    CHECK( FAKE_CalcNotify( hVar ) == false );
+    CHECK( state.channels[0].calcNotify == false );
+    CHECK( state.hot.deadline[0] != 0 );
+
+    /* periodic to on demand */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"0\" } ]",
+        "" );
+
+    CHECK( FAKE_CalcNotify( hVar ) == true );
+
+    /* on demand on another variable */
+    HARNESS_Reload( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/B0\", "
+        "    \"interval\" : \"0\" } ]",
+        "" );
+
+    CHECK( FAKE_CalcNotify( hVar ) == false );
+    CHECK( FAKE_CalcNotify( state.channels[0].hVar ) == true );
+}
+
+/*==============================================================================
+        Test
+==============================================================================*/
+
+int main( int argc, char **argv )
+{
+    int result = 1;
+
+    if ( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s stats|scan|replay|budget|calc\n", argv[0] );
+    }
+    else if ( strcmp( argv[1], "stats" ) == 0 )
+    {
+        TestStats();
+        result = 0;
+    }
+    else if ( strcmp( argv[1], "scan" ) == 0 )
+    {
+        TestScan();
+        result = 0;
+    }
+    else if ( strcmp( argv[1], "replay" ) == 0 )
+    {
+        TestReplay();
+        result = 0;
+    }
+    else if ( strcmp( argv[1], "budget" ) == 0 )
+    {
+        TestBudget();
+        result = 0;
+    }
+    else if ( strcmp( argv[1], "calc" ) == 0 )
+    {
+        TestCalc();
+        result = 0;
+    }
+    else
+    {
+        fprintf( stderr, "unknown test case %s\n", argv[1] );
+    }
+
+    return result;
+}
@@ -0,0 +1,295 @@
+/*==============================================================================
+MIT License
+
+Copyright (c) 2023 Trevor Monk
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+==============================================================================*/
+
+
+/*============================================================================*/
+/*!
+@file schedule_test.c
+
+    Schedule Accuracy Test
+
+    The schedule test runs fixed sample schedules on the simulated
+    clock and checks the deadline accuracy and overrun counts which
+    the ADS7830 status reports.  The test case is selected by the
+    first argument:
+
+    - multirate: five channels at 10 ms to 1 s keep their deadlines
+      to within the conversions which fall due at the same time, and
+      never overrun.  The simulated run is refused with the hwmon
+      backend.
+
+    - overload: eight channels at 1 ms need more bus time than there
+      is, so they overrun.
+
+    - replay: a paced recording is played by a simulated run without
+      setting any variables or taking pending on-demand requests.
+
+*/
+/*============================================================================*/
+
+/*==============================================================================
+        Includes
+==============================================================================*/
+
+#define main ads7830_main
+#include "../src/ads7830.c"
+#undef main
+
+#include "harness.h"
+#include "fake_varserver.h"
+
+/*==============================================================================
+        Private definitions
+==============================================================================*/
+
+/*! simulated run time of each test case in microseconds */
+#define SCHEDULE_DURATION 10000000ULL
+
+/*! number of lines in the replay recording, each sampling two channels */
+#define SCHEDULE_RECORDED 1000
+
+/*==============================================================================
+        Private file scoped variables
+==============================================================================*/
+
+/*! name of the replay recording */
+static char recording[] = "/tmp/ads7830-recording.XXXXXX";
+
+/*==============================================================================
+        Test cases
+==============================================================================*/
+
+/*============================================================================*/
+/*  RemoveRecording                                                           */
+/*!
+    Remove the replay recording
+
+==============================================================================*/
+static void RemoveRecording( void )
+{
+    unlink( recording );
+}
+
+/*============================================================================*/
+/*  TestMultiRate                                                             */
+/*!
+    Check the deadline accuracy of a multi-rate schedule
+
+    All five channels fall due together once a second, so the last of
+    them waits for the four conversions ahead of it.
+
+==============================================================================*/
+static void TestMultiRate( void )
+{
+    static ADS7830 state;
+    size_t sets;
+
+    HARNESS_Start( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"10\" },"
+        "  { \"channel\" : \"1\", \"var\" : \"/HW/ADS7830/A1\", "
+        "    \"interval\" : \"20\" },"
+        "  { \"channel\" : \"2\", \"var\" : \"/HW/ADS7830/A2\", "
+        "    \"interval\" : \"50\" },"
+        "  { \"channel\" : \"3\", \"var\" : \"/HW/ADS7830/A3\", "
+        "    \"interval\" : \"100\" },"
+        "  { \"channel\" : \"4\", \"var\" : \"/HW/ADS7830/A4\", "
+        "    \"interval\" : \"1000\" } ]",
+        "" );
+
+    /* the simulated run never reads a device */
+    sets = FAKE_SetCount();
+    state.simulate = 1;
+    CHECK( Simulate( &state ) == ENOTSUP );
+    CHECK( state.scheduled == 0 );
+    CHECK( FAKE_SetCount() == sets );
+
+    RunSchedule( &state, SCHEDULE_DURATION );
+
+    printf( "%llu samples, late max %llu us, %llu overruns\n",
+            (unsigned long long)state.scheduled,
+            (unsigned long long)state.lateMax,
+            (unsigned long long)state.overruns );
+
+    CHECK( state.scheduled == 1000 + 500 + 200 + 100 + 10 );
+    CHECK( state.lateMax == 4 * ADS7830_SIM_CONVERSION );
+    CHECK( state.overruns == 0 );
+}
+
+/*============================================================================*/
+/*  TestOverload                                                              */
+/*!
+    Check that an overloaded schedule overruns
+
+    Eight conversions take 3.2 ms, so eight channels at 1 ms fall
+    behind on every round.
+
+==============================================================================*/
+static void TestOverload( void )
+{
+    static ADS7830 state;
+
+    HARNESS_Start( &state,
+        "hwmon",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"1\" },"
+        "  { \"channel\" : \"1\", \"var\" : \"/HW/ADS7830/A1\", "
+        "    \"interval\" : \"1\" },"
+        "  { \"channel\" : \"2\", \"var\" : \"/HW/ADS7830/A2\", "
+        "    \"interval\" : \"1\" },"
+        "  { \"channel\" : \"3\", \"var\" : \"/HW/ADS7830/A3\", "
+        "    \"interval\" : \"1\" },"
+        "  { \"channel\" : \"4\", \"var\" : \"/HW/ADS7830/A4\", "
+        "    \"interval\" : \"1\" },"
+        "  { \"channel\" : \"5\", \"var\" : \"/HW/ADS7830/A5\", "
+        "    \"interval\" : \"1\" },"
+        "  { \"channel\" : \"6\", \"var\" : \"/HW/ADS7830/A6\", "
+        "    \"interval\" : \"1\" },"
+        "  { \"channel\" : \"7\", \"var\" : \"/HW/ADS7830/A7\", "
+        "    \"interval\" : \"1\" } ]",
+        "" );
+
+    RunSchedule( &state, SCHEDULE_DURATION );
+
+    printf( "%llu samples, late max %llu us, %llu overruns\n",
+            (unsigned long long)state.scheduled,
+            (unsigned long long)state.lateMax,
+            (unsigned long long)state.overruns );
+
+    /* the bus is busy for the whole run */
+    CHECK( state.scheduled >= SCHEDULE_DURATION / ADS7830_SIM_CONVERSION - 8 );
+    CHECK( state.overruns > 0 );
+    CHECK( state.lateMax >= 7 * ADS7830_SIM_CONVERSION );
+}
+
+/*============================================================================*/
+/*  TestReplay                                                                */
+/*!
+    Check that a simulated run plays a recording without side effects
+
+    The recording holds a sample of A0 and A1 every 5 ms.  The samples
+    of A1 are played at their recorded times even though A1 has no
+    sample interval of its own.
+
+==============================================================================*/
+static void TestReplay( void )
+{
+    static ADS7830 state;
+    char extra[128];
+    sigset_t mask;
+    size_t sets;
+    FILE *fp;
+    int fd;
+    int i;
+
+    fd = mkstemp( recording );
+    CHECK( fd != -1 );
+    atexit( RemoveRecording );
+
+    fp = fdopen( fd, "w" );
+    CHECK( fp != NULL );
+    for ( i = 0; i < SCHEDULE_RECORDED; i++ )
+    {
+        fprintf( fp, "%d,%d,%d,,,,,,\n", 5000 * i, i % 256, i % 256 );
+    }
+
+    fclose( fp );
+
+    snprintf( extra,
+              sizeof( extra ),
+              "\"replay\" : { \"file\" : \"%s\", \"speed\" : \"1\" },",
+              recording );
+
+    HARNESS_Start( &state,
+        "replay",
+        "[ { \"channel\" : \"0\", \"var\" : \"/HW/ADS7830/A0\", "
+        "    \"interval\" : \"10\" },"
+        "  { \"channel\" : \"1\", \"var\" : \"/HW/ADS7830/A1\" } ]",
+        extra );
+
+    /* leave an on-demand request pending */
+    sigemptyset( &mask );
+    sigaddset( &mask, SIG_VAR_CALC );
+    CHECK( sigprocmask( SIG_BLOCK, &mask, NULL ) == 0 );
+    CHECK( raise( SIG_VAR_CALC ) == 0 );
+
+    sets = FAKE_SetCount();
+    state.simulate = SCHEDULE_DURATION / 1000000ULL;
+    CHECK( Simulate( &state ) == EOK );
+
+    printf( "%zu of %zu recorded samples, %llu samples, "
+            "late max %llu us, %llu overruns\n",
+            state.replay.next,
+            state.replay.count,
+            (unsigned long long)state.scheduled,
+            (unsigned long long)state.lateMax,
+            (unsigned long long)state.overruns );
+
+    CHECK( state.replay.count == 2 * SCHEDULE_RECORDED );
+    CHECK( state.replay.next == state.replay.count );
+    CHECK( state.scheduled == 1000 );
+    CHECK( state.overruns == 0 );
+    CHECK( state.preemptions == 0 );
+    CHECK( FAKE_SetCount() == sets );
+
+    /* the request is still pending */
+    CHECK( sigpending( &mask ) == 0 );
+    CHECK( sigismember( &mask, SIG_VAR_CALC ) == 1 );
+}
+
+/*==============================================================================
+        Test
+==============================================================================*/
+
+int main( int argc, char **argv )
+{
+    int result = 1;
+
+    if ( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s multirate|overload|replay\n", argv[0] );
+    }
+    else if ( strcmp( argv[1], "multirate" ) == 0 )
+    {
+        TestMultiRate();
+        result = 0;
+    }
+    else if ( strcmp( argv[1], "overload" ) == 0 )
+    {
+        TestOverload();
+        result = 0;
+    }
+    else if ( strcmp( argv[1], "replay" ) == 0 )
+    {
+        TestReplay();
+        result = 0;
+    }
+    else
+    {
+        fprintf( stderr, "unknown test case %s\n", argv[1] );
+    }
+
+    return result;
+}